@@ -0,0 +1,80 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Controla a taxa de amostragem do pneu: sobe para max_rate_hz quando a inclinação
+// de curto prazo, o ruído em torno dela ou o salto desde a amostra anterior passam
+// do limiar de entrada, e depois de hold_time_ms abaixo dos limiares de saída
+// (histerese) cai pela metade a cada decay_interval_ms até idle_rate_hz.
+class AdaptiveRateController {
+public:
+    struct Config {
+        float idle_rate_hz;
+        float max_rate_hz;
+        float slope_enter_kpa_per_s;
+        float slope_exit_kpa_per_s;
+        float deviation_enter_kpa;
+        float deviation_exit_kpa;
+        uint32_t hold_time_ms;
+        uint32_t decay_interval_ms;
+    };
+
+    struct Stats {
+        float current_rate_hz;
+        float slope_kpa_per_s;
+        float deviation_kpa;
+        uint32_t samples_taken;
+        // Amostras economizadas em relação a rodar fixo em max_rate_hz
+        uint32_t samples_saved;
+        uint32_t activations;
+    };
+
+    static constexpr Config DEFAULT_CONFIG = {
+        0.5f,   // idle_rate_hz: mesmo período de 2 s da leitura fixa
+        50.0f,  // max_rate_hz
+        2.0f,   // slope_enter_kpa_per_s
+        0.5f,   // slope_exit_kpa_per_s
+        3.0f,   // deviation_enter_kpa
+        1.0f,   // deviation_exit_kpa
+        3000,   // hold_time_ms
+        1000,   // decay_interval_ms
+    };
+
+    AdaptiveRateController();
+
+    void configure(const Config& config);
+    // Alimenta uma amostra; retorna true se a taxa recomendada mudou
+    bool add_sample(int64_t timestamp_us, float pressure_kpa);
+
+    float get_current_rate_hz() const { return current_rate_hz_; }
+    uint32_t get_sample_interval_ms() const;
+    bool is_active() const { return active_; }
+    Stats get_stats() const;
+
+private:
+    // Janela da regressão: amostras dos últimos 2 s, e no mínimo as 4 últimas (taxa
+    // lenta) desde que tenham menos de 10 s
+    static constexpr size_t WINDOW_CAPACITY = 128;
+    static constexpr size_t MIN_TREND_SAMPLES = 4;
+    static constexpr int64_t TREND_WINDOW_US = 2000000;
+    static constexpr int64_t WINDOW_MAX_AGE_US = 10000000;
+
+    Config config_;
+    int64_t window_time_us_[WINDOW_CAPACITY];
+    float window_pressure_[WINDOW_CAPACITY];
+    size_t window_count_;
+    size_t window_next_;
+
+    bool active_;
+    float current_rate_hz_;
+    float slope_kpa_per_s_;
+    float deviation_kpa_;
+    int64_t last_excursion_us_;
+    int64_t last_decay_us_;
+    int64_t first_sample_us_;
+    int64_t last_sample_us_;
+    uint32_t samples_taken_;
+    uint32_t activations_;
+
+    void update_trend(int64_t now_us);
+};
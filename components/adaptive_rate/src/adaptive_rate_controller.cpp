@@ -0,0 +1,147 @@
+#include "adaptive_rate_controller.hpp"
+#include <math.h>
+
+AdaptiveRateController::AdaptiveRateController()
+    : config_(DEFAULT_CONFIG), window_time_us_{}, window_pressure_{}, window_count_(0), window_next_(0),
+      active_(false), current_rate_hz_(DEFAULT_CONFIG.idle_rate_hz), slope_kpa_per_s_(0), deviation_kpa_(0),
+      last_excursion_us_(0), last_decay_us_(0), first_sample_us_(0), last_sample_us_(0), samples_taken_(0),
+      activations_(0) {}
+
+void AdaptiveRateController::configure(const Config& config) {
+    config_ = config;
+    if (config_.idle_rate_hz <= 0) {
+        config_.idle_rate_hz = DEFAULT_CONFIG.idle_rate_hz;
+    }
+    if (config_.max_rate_hz < config_.idle_rate_hz) {
+        config_.max_rate_hz = config_.idle_rate_hz;
+    }
+    current_rate_hz_ = active_ ? config_.max_rate_hz : config_.idle_rate_hz;
+}
+
+bool AdaptiveRateController::add_sample(int64_t timestamp_us, float pressure_kpa) {
+    if (samples_taken_ == 0) {
+        first_sample_us_ = timestamp_us;
+    }
+    samples_taken_++;
+    last_sample_us_ = timestamp_us;
+
+    // Salto desde a amostra anterior: em repouso a janela tem poucas amostras e a
+    // regressão levaria alguns períodos para perceber o começo de um enchimento
+    float step_kpa = 0;
+    if (window_count_ > 0) {
+        size_t previous = (window_next_ + WINDOW_CAPACITY - 1) % WINDOW_CAPACITY;
+        step_kpa = fabsf(pressure_kpa - window_pressure_[previous]);
+    }
+
+    window_time_us_[window_next_] = timestamp_us;
+    window_pressure_[window_next_] = pressure_kpa;
+    window_next_ = (window_next_ + 1) % WINDOW_CAPACITY;
+    if (window_count_ < WINDOW_CAPACITY) {
+        window_count_++;
+    }
+
+    update_trend(timestamp_us);
+
+    float previous_rate_hz = current_rate_hz_;
+    float abs_slope = fabsf(slope_kpa_per_s_);
+    bool excursion = abs_slope > config_.slope_enter_kpa_per_s || deviation_kpa_ > config_.deviation_enter_kpa ||
+                     step_kpa > config_.deviation_enter_kpa;
+    bool calm = abs_slope < config_.slope_exit_kpa_per_s && deviation_kpa_ < config_.deviation_exit_kpa;
+
+    if (excursion) {
+        if (!active_) {
+            activations_++;
+        }
+        active_ = true;
+        current_rate_hz_ = config_.max_rate_hz;
+        last_excursion_us_ = timestamp_us;
+        last_decay_us_ = timestamp_us;
+    } else if (active_ && !calm) {
+        // Entre os limiares de saída e de entrada: mantém a taxa e reinicia a espera
+        last_excursion_us_ = timestamp_us;
+    } else if (active_ && timestamp_us - last_excursion_us_ >= (int64_t)config_.hold_time_ms * 1000 &&
+               timestamp_us - last_decay_us_ >= (int64_t)config_.decay_interval_ms * 1000) {
+        current_rate_hz_ *= 0.5f;
+        last_decay_us_ = timestamp_us;
+        if (current_rate_hz_ <= config_.idle_rate_hz) {
+            current_rate_hz_ = config_.idle_rate_hz;
+            active_ = false;
+        }
+    }
+
+    return current_rate_hz_ != previous_rate_hz;
+}
+
+// Regressão linear por mínimos quadrados sobre a janela: inclinação (kPa/s) e desvio
+// padrão dos resíduos, que captura picos e ruído que a tendência não explica
+void AdaptiveRateController::update_trend(int64_t now_us) {
+    float sum_t = 0, sum_p = 0, sum_tt = 0, sum_tp = 0;
+    size_t count = 0;
+    size_t indices[WINDOW_CAPACITY];
+
+    for (size_t i = 0; i < window_count_; i++) {
+        size_t index = (window_next_ + WINDOW_CAPACITY - 1 - i) % WINDOW_CAPACITY;
+        int64_t age_us = now_us - window_time_us_[index];
+        if (age_us > WINDOW_MAX_AGE_US || (age_us > TREND_WINDOW_US && count >= MIN_TREND_SAMPLES)) {
+            break;
+        }
+
+        // Tempo relativo à amostra mais nova, em segundos, para manter a precisão do float
+        float t = -(float)age_us / 1000000.0f;
+        float p = window_pressure_[index];
+        sum_t += t;
+        sum_p += p;
+        sum_tt += t * t;
+        sum_tp += t * p;
+        indices[count++] = index;
+    }
+
+    if (count < 3) {
+        slope_kpa_per_s_ = 0;
+        deviation_kpa_ = 0;
+        return;
+    }
+
+    float denominator = count * sum_tt - sum_t * sum_t;
+    if (denominator <= 0) {
+        slope_kpa_per_s_ = 0;
+        deviation_kpa_ = 0;
+        return;
+    }
+
+    float slope = (count * sum_tp - sum_t * sum_p) / denominator;
+    float intercept = (sum_p - slope * sum_t) / count;
+
+    float sum_residual_sq = 0;
+    for (size_t i = 0; i < count; i++) {
+        float t = -(float)(now_us - window_time_us_[indices[i]]) / 1000000.0f;
+        float residual = window_pressure_[indices[i]] - (intercept + slope * t);
+        sum_residual_sq += residual * residual;
+    }
+
+    slope_kpa_per_s_ = slope;
+    deviation_kpa_ = sqrtf(sum_residual_sq / count);
+}
+
+uint32_t AdaptiveRateController::get_sample_interval_ms() const {
+    return (uint32_t)(1000.0f / current_rate_hz_);
+}
+
+AdaptiveRateController::Stats AdaptiveRateController::get_stats() const {
+    Stats stats = {};
+    stats.current_rate_hz = current_rate_hz_;
+    stats.slope_kpa_per_s = slope_kpa_per_s_;
+    stats.deviation_kpa = deviation_kpa_;
+    stats.samples_taken = samples_taken_;
+    stats.activations = activations_;
+
+    // Referência: o mesmo intervalo amostrado o tempo todo na taxa máxima
+    if (samples_taken_ > 0) {
+        float fixed_rate_samples = (float)(last_sample_us_ - first_sample_us_) / 1000000.0f * config_.max_rate_hz + 1;
+        if (fixed_rate_samples > samples_taken_) {
+            stats.samples_saved = (uint32_t)(fixed_rate_samples - samples_taken_);
+        }
+    }
+
+    return stats;
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <stdint.h>
+
+// Coeficientes de calibração do BMP280 (0x88..0x9F), com nomes descritivos
+struct BMP280Calibration {
+    uint16_t temperature_coefficient_1;
+    int16_t temperature_coefficient_2;
+    int16_t temperature_coefficient_3;
+    uint16_t pressure_coefficient_1;
+    int16_t pressure_coefficient_2;
+    int16_t pressure_coefficient_3;
+    int16_t pressure_coefficient_4;
+    int16_t pressure_coefficient_5;
+    int16_t pressure_coefficient_6;
+    int16_t pressure_coefficient_7;
+    int16_t pressure_coefficient_8;
+    int16_t pressure_coefficient_9;
+};
+
+// Backends de compensação das fórmulas do datasheet, escolhidos em tempo de
+// compilação pelo parâmetro de template. A temperatura (e t_fine) é sempre a
+// versão inteira de 32 bits; os backends diferem só na pressão, em Pa.
+// A pressão é dividida em duas partes: Terms guarda o que depende só de t_fine
+// (divisor e deslocamento antes da divisão) e pode ser reaproveitado enquanto
+// t_fine não muda; apply_terms() é o caminho por amostra.
+struct BMP280Compensation {
+    static int32_t compensate_temperature(const BMP280Calibration& calibration, int32_t uncompensated_temperature,
+                                          int32_t* fine_temperature_output);
+};
+
+// Referência: inteiro de 64 bits com divisão de 64 bits (cara em Xtensa e RISC-V)
+struct BMP280Compensation64 : BMP280Compensation {
+    static constexpr const char* NAME = "inteiro 64 bits";
+
+    struct Terms {
+        int64_t divisor;
+        int64_t offset;
+    };
+
+    static Terms compute_terms(const BMP280Calibration& calibration, int32_t fine_temperature);
+    static float apply_terms(const BMP280Calibration& calibration, const Terms& terms, int32_t uncompensated_pressure);
+    static float compensate_pressure(const BMP280Calibration& calibration, int32_t uncompensated_pressure,
+                                     int32_t fine_temperature) {
+        return apply_terms(calibration, compute_terms(calibration, fine_temperature), uncompensated_pressure);
+    }
+};
+
+// Inteiro de 32 bits do datasheet: só divisão de 32 bits, resolução de 1 Pa
+struct BMP280Compensation32 : BMP280Compensation {
+    static constexpr const char* NAME = "inteiro 32 bits";
+
+    struct Terms {
+        uint32_t divisor;
+        int32_t offset;
+    };
+
+    static Terms compute_terms(const BMP280Calibration& calibration, int32_t fine_temperature);
+    static float apply_terms(const BMP280Calibration& calibration, const Terms& terms, int32_t uncompensated_pressure);
+    static float compensate_pressure(const BMP280Calibration& calibration, int32_t uncompensated_pressure,
+                                     int32_t fine_temperature) {
+        return apply_terms(calibration, compute_terms(calibration, fine_temperature), uncompensated_pressure);
+    }
+};
+
+// Ponto flutuante de precisão simples (a fórmula do datasheet é em double)
+struct BMP280CompensationFloat : BMP280Compensation {
+    static constexpr const char* NAME = "float";
+
+    struct Terms {
+        float scale;
+        float offset;
+    };
+
+    static Terms compute_terms(const BMP280Calibration& calibration, int32_t fine_temperature);
+    static float apply_terms(const BMP280Calibration& calibration, const Terms& terms, int32_t uncompensated_pressure);
+    static float compensate_pressure(const BMP280Calibration& calibration, int32_t uncompensated_pressure,
+                                     int32_t fine_temperature) {
+        return apply_terms(calibration, compute_terms(calibration, fine_temperature), uncompensated_pressure);
+    }
+};
+
+// Cache da parte lenta de um backend: temperatura bruta -> t_fine -> Terms. A
+// temperatura ambiente muda devagar, então por amostra sobra só apply_terms().
+template <typename Backend>
+class BMP280CompensationCache {
+public:
+    BMP280CompensationCache()
+        : valid_(false), uncompensated_temperature_(0), temperature_(0), fine_temperature_(0), terms_{} {}
+
+    // Coeficientes novos invalidam os termos guardados
+    void invalidate() { valid_ = false; }
+
+    // Temperatura em centésimos de °C; os termos da pressão só são recalculados
+    // quando t_fine muda
+    int32_t update_temperature(const BMP280Calibration& calibration, int32_t uncompensated_temperature) {
+        if (valid_ && uncompensated_temperature == uncompensated_temperature_) {
+            return temperature_;
+        }
+
+        int32_t fine_temperature;
+        temperature_ = BMP280Compensation::compensate_temperature(calibration, uncompensated_temperature,
+                                                                  &fine_temperature);
+        uncompensated_temperature_ = uncompensated_temperature;
+
+        // Temperaturas brutas diferentes podem cair no mesmo t_fine
+        if (!valid_ || fine_temperature != fine_temperature_) {
+            terms_ = Backend::compute_terms(calibration, fine_temperature);
+            fine_temperature_ = fine_temperature;
+        }
+        valid_ = true;
+        return temperature_;
+    }
+
+    // Pressão em Pa com os termos da última update_temperature()
+    float compensate_pressure(const BMP280Calibration& calibration, int32_t uncompensated_pressure) const {
+        return Backend::apply_terms(calibration, terms_, uncompensated_pressure);
+    }
+
+private:
+    bool valid_;
+    int32_t uncompensated_temperature_;
+    int32_t temperature_;
+    int32_t fine_temperature_;
+    typename Backend::Terms terms_;
+};
+
+// Backend padrão do driver: o benchmark mostra o inteiro de 32 bits dentro da
+// precisão do sensor (±12 Pa relativos) sem a divisão de 64 bits
+using BMP280DefaultCompensation = BMP280Compensation32;
@@ -0,0 +1,110 @@
+#pragma once
+#include "sdkconfig.h"
+#include "bmp280_compensation.hpp"
+#include "esp_timer.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_cpu.h"
+#endif
+#include <stddef.h>
+
+// Varre as leituras brutas (temperatura e pressão) com a calibração dada e compara
+// cada backend com a referência de 64 bits: custo por compensação (ciclos de CPU no
+// alvo, ns no host) e erro máximo dentro da faixa do sensor (300-1100 hPa, -40-85 °C).
+class BMP280CompensationBenchmark {
+public:
+    struct Result {
+        const char* name;
+        uint32_t evaluations;
+        float cost_per_compensation;
+        // Com os termos de t_fine em cache (caminho por amostra do driver)
+        float cached_cost_per_compensation;
+        float max_error_pa;
+        float mean_abs_error_pa;
+    };
+
+    // Passos da varredura: 2^20 / 4096 x 2^20 / 256 pontos brutos
+    static constexpr int32_t TEMPERATURE_STEP = 4096;
+    static constexpr int32_t PRESSURE_STEP = 256;
+    static constexpr int32_t RAW_LIMIT = 1 << 20;
+    static constexpr float MIN_VALID_PRESSURE_PA = 30000.0f;
+    static constexpr float MAX_VALID_PRESSURE_PA = 110000.0f;
+    static constexpr int32_t MIN_VALID_TEMPERATURE = -4000;
+    static constexpr int32_t MAX_VALID_TEMPERATURE = 8500;
+#if CONFIG_IDF_TARGET_LINUX
+    static constexpr const char* COST_UNIT = "ns";
+#else
+    static constexpr const char* COST_UNIT = "ciclos";
+#endif
+
+    explicit BMP280CompensationBenchmark(const BMP280Calibration& calibration) : calibration_(calibration) {}
+
+    template <typename Backend>
+    Result measure() const {
+        Result result = {};
+        result.name = Backend::NAME;
+        double error_sum = 0;
+        volatile float sink = 0;
+        uint64_t elapsed = 0;
+        uint64_t cached_elapsed = 0;
+        uint32_t timed_evaluations = 0;
+
+        for (int32_t raw_temperature = 0; raw_temperature < RAW_LIMIT; raw_temperature += TEMPERATURE_STEP) {
+            int32_t fine_temperature;
+            int32_t temperature = BMP280Compensation::compensate_temperature(calibration_, raw_temperature,
+                                                                             &fine_temperature);
+            if (temperature < MIN_VALID_TEMPERATURE || temperature > MAX_VALID_TEMPERATURE) {
+                continue;
+            }
+
+            // Tempo só da linha de compensação do backend, sem a referência
+            uint32_t start = now();
+            for (int32_t raw_pressure = 0; raw_pressure < RAW_LIMIT; raw_pressure += PRESSURE_STEP) {
+                sink = Backend::compensate_pressure(calibration_, raw_pressure, fine_temperature);
+            }
+            elapsed += (uint32_t)(now() - start);
+            timed_evaluations += RAW_LIMIT / PRESSURE_STEP;
+
+            start = now();
+            typename Backend::Terms terms = Backend::compute_terms(calibration_, fine_temperature);
+            for (int32_t raw_pressure = 0; raw_pressure < RAW_LIMIT; raw_pressure += PRESSURE_STEP) {
+                sink = Backend::apply_terms(calibration_, terms, raw_pressure);
+            }
+            cached_elapsed += (uint32_t)(now() - start);
+
+            for (int32_t raw_pressure = 0; raw_pressure < RAW_LIMIT; raw_pressure += PRESSURE_STEP) {
+                float reference = BMP280Compensation64::compensate_pressure(calibration_, raw_pressure,
+                                                                            fine_temperature);
+                if (reference < MIN_VALID_PRESSURE_PA || reference > MAX_VALID_PRESSURE_PA) {
+                    continue;
+                }
+
+                float error = Backend::compensate_pressure(calibration_, raw_pressure, fine_temperature) - reference;
+                error = (error < 0) ? -error : error;
+                result.max_error_pa = (error > result.max_error_pa) ? error : result.max_error_pa;
+                error_sum += error;
+                result.evaluations++;
+            }
+        }
+        (void)sink;
+
+        result.cost_per_compensation = (timed_evaluations > 0) ? (float)elapsed / timed_evaluations : 0;
+        result.cached_cost_per_compensation = (timed_evaluations > 0) ? (float)cached_elapsed / timed_evaluations : 0;
+        result.mean_abs_error_pa = (result.evaluations > 0) ? (float)(error_sum / result.evaluations) : 0;
+        return result;
+    }
+
+    void log_result(const Result& result) const;
+    void run_all() const;
+
+private:
+    BMP280Calibration calibration_;
+
+    // Contador de 32 bits: cada trecho medido fica bem abaixo de uma volta
+    static uint32_t now() {
+#if CONFIG_IDF_TARGET_LINUX
+        return (uint32_t)(esp_timer_get_time() * 1000);
+#else
+        return esp_cpu_get_cycle_count();
+#endif
+    }
+};
@@ -1,49 +1,148 @@
 #pragma once
 #include "esp_err.h"
 #include "i2c_manager.hpp"
+#include "bmp280_compensation.hpp"
 
-class BMP280Driver {
+// O backend de compensação da pressão é escolhido em tempo de compilação pelo
+// parâmetro do template (BMP280Compensation64, BMP280Compensation32 ou
+// BMP280CompensationFloat); BMP280Driver é o driver com o backend padrão.
+template <typename Compensation = BMP280DefaultCompensation>
+class BasicBMP280Driver {
 public:
-    BMP280Driver(I2CManager* i2c_manager, uint8_t device_address);
-    ~BMP280Driver();
+    using PressureCompensation = Compensation;
+
+    // Valores dos campos osrs_t/osrs_p de ctrl_meas (0xF4)
+    enum class Oversampling : uint8_t {
+        SKIPPED = 0,
+        X1 = 1,
+        X2 = 2,
+        X4 = 3,
+        X8 = 4,
+        X16 = 5
+    };
+
+    // Coeficiente do filtro IIR, campo filter de config (0xF5)
+    enum class FilterCoefficient : uint8_t {
+        OFF = 0,
+        X2 = 1,
+        X4 = 2,
+        X8 = 3,
+        X16 = 4
+    };
+
+    // Tempo de standby entre medições no modo normal, campo t_sb de config (0xF5)
+    enum class StandbyTime : uint8_t {
+        MS_0_5 = 0,
+        MS_62_5 = 1,
+        MS_125 = 2,
+        MS_250 = 3,
+        MS_500 = 4,
+        MS_1000 = 5,
+        MS_2000 = 6,
+        MS_4000 = 7
+    };
+
+    enum class PowerMode : uint8_t {
+        SLEEP = 0,
+        FORCED = 1,
+        NORMAL = 3
+    };
+
+    struct MeasurementConfig {
+        Oversampling temperature_oversampling;
+        Oversampling pressure_oversampling;
+        FilterCoefficient filter;
+        StandbyTime standby;
+        PowerMode mode;
+    };
+
+    // Perfis dos casos de uso recomendados no datasheet
+    enum class MeasurementProfile {
+        LOW_POWER,       // Forçado, x1/x1, sem filtro: uma conversão curta por leitura
+        BALANCED,        // Normal, T x1 / P x4, IIR 4, standby 125 ms
+        HIGH_RESOLUTION, // Normal, T x2 / P x16, IIR 16, standby 0,5 ms
+        HIGH_RATE        // Normal, T x1 / P x2, sem filtro, standby 0,5 ms
+    };
+
+    // Leitura com dados brutos; timestamp_us é o fim estimado da conversão usada,
+    // com incerteza de ±timestamp_uncertainty_us (no modo normal, até meio ciclo)
+    struct Reading {
+        int32_t raw_temperature;
+        int32_t raw_pressure;
+        float temperature_celsius;
+        float pressure_hectopascal;
+        int64_t timestamp_us;
+        uint32_t timestamp_uncertainty_us;
+    };
+
+    BasicBMP280Driver(I2CManager* i2c_manager, uint8_t device_address);
+    ~BasicBMP280Driver();
 
     esp_err_t initialize_sensor();
     esp_err_t read_temperature_and_pressure(float* temperature_celsius, float* pressure_hectopascal);
+
+    // Medição em duas fases, como no SMP3011: no modo forçado start_measurement()
+    // dispara a conversão; no normal só marca o pedido. fetch_reading() devolve
+    // ESP_ERR_NOT_FINISHED enquanto a conversão não terminou.
+    esp_err_t start_measurement(uint32_t* ready_in_us = nullptr);
+    esp_err_t poll_ready(bool* ready);
+    esp_err_t fetch_reading(Reading* reading);
+    uint32_t get_ready_time_hint_us() const;
+    bool is_measurement_pending() const { return measurement_pending_; }
+    const Reading& get_last_reading() const { return last_reading_; }
     bool is_sensor_initialized() const { return sensor_initialized_; }
+    const BMP280Calibration& get_calibration() const { return calibration_data_; }
+
+    static MeasurementConfig get_profile_config(MeasurementProfile profile);
+    esp_err_t set_profile(MeasurementProfile profile);
+    esp_err_t set_measurement_config(const MeasurementConfig& config);
+    const MeasurementConfig& get_measurement_config() const { return measurement_config_; }
+    // Tempo máximo de uma conversão com a configuração atual (datasheet), µs
+    uint32_t get_measurement_time_us() const;
+    // Modo normal: conversão mais standby, o intervalo entre resultados novos, µs
+    uint32_t get_normal_cycle_us() const;
 
 private:
     I2CManager* i2c_manager_;
     uint8_t device_address_;
     bool sensor_initialized_;
 
-    // Dados de calibração com nomes descritivos
-    struct CalibrationData {
-        uint16_t temperature_coefficient_1;
-        int16_t temperature_coefficient_2;
-        int16_t temperature_coefficient_3;
-        uint16_t pressure_coefficient_1;
-        int16_t pressure_coefficient_2;
-        int16_t pressure_coefficient_3;
-        int16_t pressure_coefficient_4;
-        int16_t pressure_coefficient_5;
-        int16_t pressure_coefficient_6;
-        int16_t pressure_coefficient_7;
-        int16_t pressure_coefficient_8;
-        int16_t pressure_coefficient_9;
-    } calibration_data_;
+    BMP280Calibration calibration_data_;
+    MeasurementConfig measurement_config_;
+    // Modo normal: instante em que a primeira medição com a configuração nova fica pronta
+    int64_t normal_data_ready_us_;
+
+    // Conversão em andamento
+    bool measurement_pending_;
+    int64_t measurement_ready_us_;
+    uint32_t status_polls_;
+    Reading last_reading_;
+
+    // Termos de t_fine do backend escolhido
+    BMP280CompensationCache<Compensation> compensation_cache_;
 
     // Registros do BMP280
     static constexpr uint8_t REGISTER_CHIP_ID = 0xD0;
     static constexpr uint8_t REGISTER_RESET = 0xE0;
     static constexpr uint8_t REGISTER_CALIBRATION_START = 0x88;
+    static constexpr uint8_t REGISTER_STATUS = 0xF3;
     static constexpr uint8_t REGISTER_CONTROL_MEASUREMENT = 0xF4;
+    static constexpr uint8_t REGISTER_CONFIG = 0xF5;
     static constexpr uint8_t REGISTER_DATA_START = 0xF7;
     
     static constexpr uint8_t CHIP_ID_EXPECTED = 0x58;
     static constexpr uint8_t RESET_COMMAND = 0xB6;
+    static constexpr uint8_t STATUS_MEASURING = 0x08;
+    // Consultas ao status depois do tempo máximo de conversão antes de desistir
+    static constexpr uint32_t STATUS_POLL_LIMIT = 5;
 
     esp_err_t read_calibration_data();
     esp_err_t configure_sensor_operation();
-    int32_t compensate_temperature_reading(int32_t uncompensated_temperature, int32_t* fine_temperature_output);
-    uint32_t compensate_pressure_reading(int32_t uncompensated_pressure, int32_t fine_temperature);
-};
\ No newline at end of file
+    uint8_t build_control_measurement(PowerMode mode) const;
+};
+
+extern template class BasicBMP280Driver<BMP280Compensation64>;
+extern template class BasicBMP280Driver<BMP280Compensation32>;
+extern template class BasicBMP280Driver<BMP280CompensationFloat>;
+
+using BMP280Driver = BasicBMP280Driver<>;
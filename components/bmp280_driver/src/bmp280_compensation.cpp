@@ -0,0 +1,118 @@
+#include "bmp280_compensation.hpp"
+
+int32_t BMP280Compensation::compensate_temperature(const BMP280Calibration& calibration,
+                                                   int32_t uncompensated_temperature,
+                                                   int32_t* fine_temperature_output) {
+    int32_t variable_1 = ((((uncompensated_temperature >> 3) - 
+                          ((int32_t)calibration.temperature_coefficient_1 << 1))) * 
+                         ((int32_t)calibration.temperature_coefficient_2)) >> 11;
+
+    int32_t variable_2 = (((((uncompensated_temperature >> 4) - 
+                           (int32_t)calibration.temperature_coefficient_1) * 
+                          ((uncompensated_temperature >> 4) - 
+                           (int32_t)calibration.temperature_coefficient_1)) >> 12) * 
+                         ((int32_t)calibration.temperature_coefficient_3)) >> 14;
+
+    *fine_temperature_output = variable_1 + variable_2;
+    
+    int32_t temperature = (*fine_temperature_output * 5 + 128) >> 8;
+    return temperature;
+}
+
+BMP280Compensation64::Terms BMP280Compensation64::compute_terms(const BMP280Calibration& calibration,
+                                                                int32_t fine_temperature) {
+    int64_t variable_1 = ((int64_t)fine_temperature) - 128000;
+    int64_t variable_2 = variable_1 * variable_1 * (int64_t)calibration.pressure_coefficient_6;
+    variable_2 = variable_2 + ((variable_1 * (int64_t)calibration.pressure_coefficient_5) << 17);
+    variable_2 = variable_2 + (((int64_t)calibration.pressure_coefficient_4) << 35);
+    
+    variable_1 = ((variable_1 * variable_1 * (int64_t)calibration.pressure_coefficient_3) >> 8) + 
+                 ((variable_1 * (int64_t)calibration.pressure_coefficient_2) << 12);
+    variable_1 = ((((int64_t)1 << 47) + variable_1)) * ((int64_t)calibration.pressure_coefficient_1) >> 33;
+
+    Terms terms = {variable_1, variable_2};
+    return terms;
+}
+
+float BMP280Compensation64::apply_terms(const BMP280Calibration& calibration, const Terms& terms,
+                                        int32_t uncompensated_pressure) {
+    if (terms.divisor == 0) {
+        return 0;
+    }
+
+    int64_t pressure = 1048576 - uncompensated_pressure;
+    pressure = (((pressure << 31) - terms.offset) * 3125) / terms.divisor;
+    
+    int64_t variable_1 = (((int64_t)calibration.pressure_coefficient_9) * (pressure >> 13) * (pressure >> 13)) >> 25;
+    int64_t variable_2 = (((int64_t)calibration.pressure_coefficient_8) * pressure) >> 19;
+    
+    pressure = ((pressure + variable_1 + variable_2) >> 8) + (((int64_t)calibration.pressure_coefficient_7) << 4);
+
+    // Resultado em Q24.8 Pa
+    return (uint32_t)pressure / 256.0f;
+}
+
+BMP280Compensation32::Terms BMP280Compensation32::compute_terms(const BMP280Calibration& calibration,
+                                                                int32_t fine_temperature) {
+    int32_t variable_1 = (fine_temperature >> 1) - 64000;
+    int32_t variable_2 = (((variable_1 >> 2) * (variable_1 >> 2)) >> 11) * (int32_t)calibration.pressure_coefficient_6;
+    variable_2 = variable_2 + ((variable_1 * (int32_t)calibration.pressure_coefficient_5) << 1);
+    variable_2 = (variable_2 >> 2) + ((int32_t)calibration.pressure_coefficient_4 << 16);
+
+    variable_1 = ((((int32_t)calibration.pressure_coefficient_3 * (((variable_1 >> 2) * (variable_1 >> 2)) >> 13)) >> 3) +
+                  (((int32_t)calibration.pressure_coefficient_2 * variable_1) >> 1)) >> 18;
+    variable_1 = ((32768 + variable_1) * (int32_t)calibration.pressure_coefficient_1) >> 15;
+
+    Terms terms = {(uint32_t)variable_1, variable_2 >> 12};
+    return terms;
+}
+
+float BMP280Compensation32::apply_terms(const BMP280Calibration& calibration, const Terms& terms,
+                                        int32_t uncompensated_pressure) {
+    if (terms.divisor == 0) {
+        return 0;
+    }
+
+    uint32_t pressure = ((uint32_t)(1048576 - uncompensated_pressure) - (uint32_t)terms.offset) * 3125;
+    // Evita estouro: acima de 2^31 divide antes de dobrar
+    if (pressure < 0x80000000) {
+        pressure = (pressure << 1) / terms.divisor;
+    } else {
+        pressure = (pressure / terms.divisor) * 2;
+    }
+
+    int32_t variable_1 = ((int32_t)calibration.pressure_coefficient_9 * (int32_t)(((pressure >> 3) * (pressure >> 3)) >> 13)) >> 12;
+    int32_t variable_2 = ((int32_t)(pressure >> 2) * (int32_t)calibration.pressure_coefficient_8) >> 13;
+
+    return (float)(uint32_t)((int32_t)pressure + ((variable_1 + variable_2 + calibration.pressure_coefficient_7) >> 4));
+}
+
+BMP280CompensationFloat::Terms BMP280CompensationFloat::compute_terms(const BMP280Calibration& calibration,
+                                                                      int32_t fine_temperature) {
+    float variable_1 = (float)fine_temperature * 0.5f - 64000.0f;
+    float variable_2 = variable_1 * variable_1 * (float)calibration.pressure_coefficient_6 * (1.0f / 32768.0f);
+    variable_2 = variable_2 + variable_1 * (float)calibration.pressure_coefficient_5 * 2.0f;
+    variable_2 = variable_2 * 0.25f + (float)calibration.pressure_coefficient_4 * 65536.0f;
+
+    variable_1 = ((float)calibration.pressure_coefficient_3 * variable_1 * variable_1 * (1.0f / 524288.0f) +
+                  (float)calibration.pressure_coefficient_2 * variable_1) * (1.0f / 524288.0f);
+    variable_1 = (1.0f + variable_1 * (1.0f / 32768.0f)) * (float)calibration.pressure_coefficient_1;
+
+    // A divisão por variable_1 vira multiplicação pelo fator guardado
+    Terms terms = {(variable_1 != 0.0f) ? 6250.0f / variable_1 : 0.0f, variable_2 * (1.0f / 4096.0f)};
+    return terms;
+}
+
+float BMP280CompensationFloat::apply_terms(const BMP280Calibration& calibration, const Terms& terms,
+                                           int32_t uncompensated_pressure) {
+    if (terms.scale == 0.0f) {
+        return 0;
+    }
+
+    float pressure = (1048576.0f - (float)uncompensated_pressure - terms.offset) * terms.scale;
+
+    float variable_1 = (float)calibration.pressure_coefficient_9 * pressure * pressure * (1.0f / 2147483648.0f);
+    float variable_2 = pressure * (float)calibration.pressure_coefficient_8 * (1.0f / 32768.0f);
+
+    return pressure + (variable_1 + variable_2 + (float)calibration.pressure_coefficient_7) * (1.0f / 16.0f);
+}
@@ -0,0 +1,16 @@
+#include "bmp280_compensation_benchmark.hpp"
+#include "esp_log.h"
+
+static const char *TAG = "BMP280Benchmark";
+
+void BMP280CompensationBenchmark::log_result(const Result& result) const {
+    ESP_LOGI(TAG, "%-16s %7.1f %s/compensação (%.1f com termos em cache), erro máx %6.3f Pa, médio %6.3f Pa "
+             "(%lu pontos)", result.name, result.cost_per_compensation, COST_UNIT, result.cached_cost_per_compensation,
+             result.max_error_pa, result.mean_abs_error_pa, (unsigned long)result.evaluations);
+}
+
+void BMP280CompensationBenchmark::run_all() const {
+    log_result(measure<BMP280Compensation64>());
+    log_result(measure<BMP280Compensation32>());
+    log_result(measure<BMP280CompensationFloat>());
+}
@@ -1,22 +1,34 @@
 #include "bmp280_driver.hpp"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 static const char *TAG = "BMP280Driver";
 
-BMP280Driver::BMP280Driver(I2CManager* i2c_manager, uint8_t device_address) 
-    : i2c_manager_(i2c_manager), device_address_(device_address), sensor_initialized_(false) {
+template <typename Compensation>
+BasicBMP280Driver<Compensation>::BasicBMP280Driver(I2CManager* i2c_manager, uint8_t device_address) 
+    : i2c_manager_(i2c_manager), device_address_(device_address), sensor_initialized_(false),
+      measurement_config_(get_profile_config(MeasurementProfile::LOW_POWER)), normal_data_ready_us_(0),
+      measurement_pending_(false), measurement_ready_us_(0), status_polls_(0), last_reading_{} {
     
     // Inicializar estrutura de calibração com zeros
     calibration_data_ = {};
 }
 
-BMP280Driver::~BMP280Driver() {
+template <typename Compensation>
+BasicBMP280Driver<Compensation>::~BasicBMP280Driver() {
     ESP_LOGI(TAG, "BMP280 driver destruído");
 }
 
-esp_err_t BMP280Driver::initialize_sensor() {
+template <typename Compensation>
+esp_err_t BasicBMP280Driver<Compensation>::initialize_sensor() {
     ESP_LOGI(TAG, "Inicializando sensor BMP280 no endereço 0x%02X", device_address_);
 
+    // Leituras do sensor têm prioridade máxima no barramento
+    i2c_manager_->set_device_priority(device_address_, I2CManager::BusPriority::SENSOR_ACQUISITION);
+
+    // A interface I2C do BMP280 suporta até 3,4 MHz
+    i2c_manager_->set_device_max_speed(device_address_, I2CManager::BusSpeed::FAST_PLUS);
+
     // Resetar o dispositivo
     esp_err_t operation_result = i2c_manager_->write_register(device_address_, REGISTER_RESET, RESET_COMMAND);
     if (operation_result != ESP_OK) {
@@ -62,7 +74,8 @@ esp_err_t BMP280Driver::initialize_sensor() {
     return ESP_OK;
 }
 
-esp_err_t BMP280Driver::read_calibration_data() {
+template <typename Compensation>
+esp_err_t BasicBMP280Driver<Compensation>::read_calibration_data() {
     uint8_t calibration_buffer[24];
     esp_err_t operation_result = i2c_manager_->read_register(device_address_, REGISTER_CALIBRATION_START, 
                                                            calibration_buffer, sizeof(calibration_buffer));
@@ -86,85 +99,255 @@ esp_err_t BMP280Driver::read_calibration_data() {
     calibration_data_.pressure_coefficient_8 = (calibration_buffer[21] << 8) | calibration_buffer[20];
     calibration_data_.pressure_coefficient_9 = (calibration_buffer[23] << 8) | calibration_buffer[22];
 
+    // Coeficientes novos invalidam os termos guardados
+    compensation_cache_.invalidate();
+
     ESP_LOGI(TAG, "Dados de calibração lidos com sucesso");
     return ESP_OK;
 }
 
-esp_err_t BMP280Driver::configure_sensor_operation() {
-    // Configurar: oversampling temperatura x2, pressão x16, modo normal
-    uint8_t control_configuration = (0x02 << 5) | (0x05 << 2) | 0x03;
-    return i2c_manager_->write_register(device_address_, REGISTER_CONTROL_MEASUREMENT, control_configuration);
+template <typename Compensation>
+esp_err_t BasicBMP280Driver<Compensation>::configure_sensor_operation() {
+    return set_measurement_config(measurement_config_);
 }
 
-esp_err_t BMP280Driver::read_temperature_and_pressure(float* temperature_celsius, float* pressure_hectopascal) {
-    if (!sensor_initialized_) {
-        ESP_LOGE(TAG, "Sensor não inicializado");
-        return ESP_ERR_INVALID_STATE;
+template <typename Compensation>
+typename BasicBMP280Driver<Compensation>::MeasurementConfig BasicBMP280Driver<Compensation>::get_profile_config(MeasurementProfile profile) {
+    switch (profile) {
+        case MeasurementProfile::BALANCED:
+            return {Oversampling::X1, Oversampling::X4, FilterCoefficient::X4, StandbyTime::MS_125, PowerMode::NORMAL};
+        case MeasurementProfile::HIGH_RESOLUTION:
+            return {Oversampling::X2, Oversampling::X16, FilterCoefficient::X16, StandbyTime::MS_0_5, PowerMode::NORMAL};
+        case MeasurementProfile::HIGH_RATE:
+            return {Oversampling::X1, Oversampling::X2, FilterCoefficient::OFF, StandbyTime::MS_0_5, PowerMode::NORMAL};
+        case MeasurementProfile::LOW_POWER:
+        default:
+            return {Oversampling::X1, Oversampling::X1, FilterCoefficient::OFF, StandbyTime::MS_0_5, PowerMode::FORCED};
     }
+}
 
-    uint8_t sensor_readings[6];
-    esp_err_t operation_result = i2c_manager_->read_register(device_address_, REGISTER_DATA_START, 
-                                                           sensor_readings, sizeof(sensor_readings));
+template <typename Compensation>
+esp_err_t BasicBMP280Driver<Compensation>::set_profile(MeasurementProfile profile) {
+    const char* profile_names[] = {"baixo consumo", "equilibrado", "alta resolução", "alta taxa"};
+    ESP_LOGI(TAG, "Perfil de medição: %s", profile_names[static_cast<int>(profile)]);
+    return set_measurement_config(get_profile_config(profile));
+}
+
+template <typename Compensation>
+uint8_t BasicBMP280Driver<Compensation>::build_control_measurement(PowerMode mode) const {
+    return (static_cast<uint8_t>(measurement_config_.temperature_oversampling) << 5) |
+           (static_cast<uint8_t>(measurement_config_.pressure_oversampling) << 2) | static_cast<uint8_t>(mode);
+}
+
+template <typename Compensation>
+esp_err_t BasicBMP280Driver<Compensation>::set_measurement_config(const MeasurementConfig& config) {
+    measurement_config_ = config;
+
+    // Escritas em config podem ser ignoradas fora do modo sleep: parar, configurar
+    // filtro e standby, e só então escolher o modo
+    esp_err_t result = i2c_manager_->write_register(device_address_, REGISTER_CONTROL_MEASUREMENT,
+                                                    build_control_measurement(PowerMode::SLEEP));
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    uint8_t config_register = (static_cast<uint8_t>(config.standby) << 5) | (static_cast<uint8_t>(config.filter) << 2);
+    result = i2c_manager_->write_register(device_address_, REGISTER_CONFIG, config_register);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    // No modo forçado cada leitura dispara a própria conversão
+    if (config.mode == PowerMode::NORMAL) {
+        result = i2c_manager_->write_register(device_address_, REGISTER_CONTROL_MEASUREMENT,
+                                              build_control_measurement(PowerMode::NORMAL));
+        normal_data_ready_us_ = esp_timer_get_time() + get_measurement_time_us();
+    }
+
+    ESP_LOGD(TAG, "Configuração: ctrl_meas=0x%02X config=0x%02X", build_control_measurement(config.mode),
+             config_register);
+    return result;
+}
+
+template <typename Compensation>
+uint32_t BasicBMP280Driver<Compensation>::get_measurement_time_us() const {
+    // Datasheet, tempo máximo: 1,25 ms + 2,3 ms por amostra de T e de P + 0,575 ms com P
+    static const uint8_t SAMPLES[] = {0, 1, 2, 4, 8, 16};
+    uint32_t temperature_samples = SAMPLES[static_cast<uint8_t>(measurement_config_.temperature_oversampling)];
+    uint32_t pressure_samples = SAMPLES[static_cast<uint8_t>(measurement_config_.pressure_oversampling)];
+
+    uint32_t time_us = 1250 + 2300 * temperature_samples + 2300 * pressure_samples;
+    if (pressure_samples > 0) {
+        time_us += 575;
+    }
+    return time_us;
+}
+
+template <typename Compensation>
+uint32_t BasicBMP280Driver<Compensation>::get_normal_cycle_us() const {
+    static const uint32_t STANDBY_US[] = {500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000};
+    return get_measurement_time_us() + STANDBY_US[static_cast<uint8_t>(measurement_config_.standby)];
+}
+
+// Versão bloqueante sobre a API de duas fases
+template <typename Compensation>
+esp_err_t BasicBMP280Driver<Compensation>::read_temperature_and_pressure(float* temperature_celsius, float* pressure_hectopascal) {
+    uint32_t ready_in_us = 0;
+    esp_err_t operation_result = start_measurement(&ready_in_us);
     if (operation_result != ESP_OK) {
-        ESP_LOGE(TAG, "Falha ao ler dados do sensor: %s", esp_err_to_name(operation_result));
         return operation_result;
     }
 
-    // Combinar bytes para valores brutos
-    int32_t uncompensated_pressure = (sensor_readings[0] << 12) | (sensor_readings[1] << 4) | (sensor_readings[2] >> 4);
-    int32_t uncompensated_temperature = (sensor_readings[3] << 12) | (sensor_readings[4] << 4) | (sensor_readings[5] >> 4);
+    // Aguardar conversão
+    vTaskDelay(pdMS_TO_TICKS((ready_in_us + 999) / 1000));
 
-    // Compensação
-    int32_t fine_temperature;
-    int32_t compensated_temperature = compensate_temperature_reading(uncompensated_temperature, &fine_temperature);
-    uint32_t compensated_pressure = compensate_pressure_reading(uncompensated_pressure, fine_temperature);
+    Reading reading;
+    while ((operation_result = fetch_reading(&reading)) == ESP_ERR_NOT_FINISHED) {
+        vTaskDelay(1);
+    }
+    if (operation_result != ESP_OK) {
+        return operation_result;
+    }
 
-    // Converter para unidades padrão
-    *temperature_celsius = compensated_temperature / 100.0f;
-    *pressure_hectopascal = compensated_pressure / 25600.0f;
+    *temperature_celsius = reading.temperature_celsius;
+    *pressure_hectopascal = reading.pressure_hectopascal;
+    return ESP_OK;
+}
+
+template <typename Compensation>
+esp_err_t BasicBMP280Driver<Compensation>::start_measurement(uint32_t* ready_in_us) {
+    if (!sensor_initialized_) {
+        ESP_LOGE(TAG, "Sensor não inicializado");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    int64_t now_us = esp_timer_get_time();
+    if (measurement_config_.mode == PowerMode::FORCED) {
+        esp_err_t result = i2c_manager_->write_register(device_address_, REGISTER_CONTROL_MEASUREMENT,
+                                                        build_control_measurement(PowerMode::FORCED));
+        if (result != ESP_OK) {
+            ESP_LOGE(TAG, "Falha ao disparar conversão: %s", esp_err_to_name(result));
+            measurement_pending_ = false;
+            return result;
+        }
+        measurement_ready_us_ = now_us + get_measurement_time_us();
+    } else {
+        // Modo normal: os registradores de dados já têm a última conversão, exceto
+        // logo depois de uma reconfiguração
+        measurement_ready_us_ = (normal_data_ready_us_ > now_us) ? normal_data_ready_us_ : now_us;
+    }
 
-    ESP_LOGD(TAG, "Leitura: %.1f°C, %.1f hPa", *temperature_celsius, *pressure_hectopascal);
+    measurement_pending_ = true;
+    status_polls_ = 0;
+    if (ready_in_us != nullptr) {
+        *ready_in_us = get_ready_time_hint_us();
+    }
     return ESP_OK;
 }
 
-int32_t BMP280Driver::compensate_temperature_reading(int32_t uncompensated_temperature, int32_t* fine_temperature_output) {
-    int32_t variable_1 = ((((uncompensated_temperature >> 3) - 
-                          ((int32_t)calibration_data_.temperature_coefficient_1 << 1))) * 
-                         ((int32_t)calibration_data_.temperature_coefficient_2)) >> 11;
+template <typename Compensation>
+uint32_t BasicBMP280Driver<Compensation>::get_ready_time_hint_us() const {
+    if (!measurement_pending_) {
+        return 0;
+    }
 
-    int32_t variable_2 = (((((uncompensated_temperature >> 4) - 
-                           (int32_t)calibration_data_.temperature_coefficient_1) * 
-                          ((uncompensated_temperature >> 4) - 
-                           (int32_t)calibration_data_.temperature_coefficient_1)) >> 12) * 
-                         ((int32_t)calibration_data_.temperature_coefficient_3)) >> 14;
+    int64_t remaining_us = measurement_ready_us_ - esp_timer_get_time();
+    return (remaining_us <= 0) ? 0 : (uint32_t)remaining_us;
+}
 
-    *fine_temperature_output = variable_1 + variable_2;
-    
-    int32_t temperature = (*fine_temperature_output * 5 + 128) >> 8;
-    return temperature;
+// Modo forçado: depois do tempo máximo de conversão consulta o bit measuring de
+// 0xF3; desiste após STATUS_POLL_LIMIT consultas ainda ocupadas
+template <typename Compensation>
+esp_err_t BasicBMP280Driver<Compensation>::poll_ready(bool* ready) {
+    if (!measurement_pending_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    *ready = false;
+    if (get_ready_time_hint_us() > 0) {
+        return ESP_OK;
+    }
+
+    if (measurement_config_.mode != PowerMode::FORCED) {
+        *ready = true;
+        return ESP_OK;
+    }
+
+    uint8_t status;
+    esp_err_t result = i2c_manager_->read_register(device_address_, REGISTER_STATUS, &status, 1);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    if ((status & STATUS_MEASURING) == 0) {
+        *ready = true;
+        return ESP_OK;
+    }
+
+    if (++status_polls_ >= STATUS_POLL_LIMIT) {
+        ESP_LOGW(TAG, "Conversão forçada não terminou em %lu us", (unsigned long)get_measurement_time_us());
+        measurement_pending_ = false;
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
 }
 
-uint32_t BMP280Driver::compensate_pressure_reading(int32_t uncompensated_pressure, int32_t fine_temperature) {
-    int64_t variable_1 = ((int64_t)fine_temperature) - 128000;
-    int64_t variable_2 = variable_1 * variable_1 * (int64_t)calibration_data_.pressure_coefficient_6;
-    variable_2 = variable_2 + ((variable_1 * (int64_t)calibration_data_.pressure_coefficient_5) << 17);
-    variable_2 = variable_2 + (((int64_t)calibration_data_.pressure_coefficient_4) << 35);
-    
-    variable_1 = ((variable_1 * variable_1 * (int64_t)calibration_data_.pressure_coefficient_3) >> 8) + 
-                 ((variable_1 * (int64_t)calibration_data_.pressure_coefficient_2) << 12);
-    variable_1 = ((((int64_t)1 << 47) + variable_1)) * ((int64_t)calibration_data_.pressure_coefficient_1) >> 33;
+template <typename Compensation>
+esp_err_t BasicBMP280Driver<Compensation>::fetch_reading(Reading* reading) {
+    bool ready = false;
+    esp_err_t operation_result = poll_ready(&ready);
+    if (operation_result != ESP_OK) {
+        return operation_result;
+    }
+    if (!ready) {
+        return ESP_ERR_NOT_FINISHED;
+    }
+    measurement_pending_ = false;
 
-    if (variable_1 == 0) {
-        return 0;
+    uint8_t sensor_readings[6];
+    operation_result = i2c_manager_->read_register(device_address_, REGISTER_DATA_START, 
+                                                   sensor_readings, sizeof(sensor_readings));
+    if (operation_result != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao ler dados do sensor: %s", esp_err_to_name(operation_result));
+        return operation_result;
     }
 
-    int64_t pressure = 1048576 - uncompensated_pressure;
-    pressure = (((pressure << 31) - variable_2) * 3125) / variable_1;
-    
-    variable_1 = (((int64_t)calibration_data_.pressure_coefficient_9) * (pressure >> 13) * (pressure >> 13)) >> 25;
-    variable_2 = (((int64_t)calibration_data_.pressure_coefficient_8) * pressure) >> 19;
-    
-    pressure = ((pressure + variable_1 + variable_2) >> 8) + (((int64_t)calibration_data_.pressure_coefficient_7) << 4);
-    
-    return (uint32_t)pressure;
-}
\ No newline at end of file
+    // Combinar bytes para valores brutos
+    Reading captured = {};
+    captured.raw_pressure = (sensor_readings[0] << 12) | (sensor_readings[1] << 4) | (sensor_readings[2] >> 4);
+    captured.raw_temperature = (sensor_readings[3] << 12) | (sensor_readings[4] << 4) | (sensor_readings[5] >> 4);
+
+    // Compensação: termos de temperatura do cache, pressão por amostra
+    int32_t compensated_temperature = compensation_cache_.update_temperature(calibration_data_,
+                                                                             captured.raw_temperature);
+    float compensated_pressure = compensation_cache_.compensate_pressure(calibration_data_, captured.raw_pressure);
+
+    // Converter para unidades padrão
+    captured.temperature_celsius = compensated_temperature / 100.0f;
+    captured.pressure_hectopascal = compensated_pressure / 100.0f;
+
+    // Forçado: a conversão terminou no máximo no tempo previsto. Normal: a última
+    // conversão terminou em algum ponto do último ciclo (não antes da primeira após
+    // a reconfiguração); vale o meio dessa janela, com meia janela de incerteza
+    int64_t now_us = esp_timer_get_time();
+    if (measurement_config_.mode == PowerMode::FORCED) {
+        captured.timestamp_us = (measurement_ready_us_ < now_us) ? measurement_ready_us_ : now_us;
+    } else {
+        int64_t earliest_us = now_us - get_normal_cycle_us();
+        int64_t first_conversion_us = normal_data_ready_us_ - get_measurement_time_us();
+        earliest_us = (first_conversion_us > earliest_us) ? first_conversion_us : earliest_us;
+        earliest_us = (earliest_us < now_us) ? earliest_us : now_us;
+        captured.timestamp_uncertainty_us = (uint32_t)((now_us - earliest_us) / 2);
+        captured.timestamp_us = now_us - captured.timestamp_uncertainty_us;
+    }
+    last_reading_ = captured;
+    *reading = captured;
+
+    ESP_LOGD(TAG, "Leitura: %.1f°C, %.1f hPa", captured.temperature_celsius, captured.pressure_hectopascal);
+    return ESP_OK;
+}
+
+// Backends disponíveis; o código do driver fica aqui, fora do cabeçalho
+template class BasicBMP280Driver<BMP280Compensation64>;
+template class BasicBMP280Driver<BMP280Compensation32>;
+template class BasicBMP280Driver<BMP280CompensationFloat>;
@@ -0,0 +1,43 @@
+#pragma once
+#include "esp_err.h"
+#include "i2c_manager.hpp"
+
+// Mapa de dispositivos de um barramento persistido em NVS. No boot só os endereços
+// do cache são verificados; um scan completo (com timeout curto) só ocorre quando o
+// cache não existe ou diverge do barramento.
+class BusTopologyCache {
+public:
+    static constexpr size_t MAX_CACHED_DEVICES = 8;
+
+    struct DeviceMap {
+        uint8_t version;
+        uint8_t device_count;
+        uint8_t addresses[MAX_CACHED_DEVICES];
+    };
+
+    BusTopologyCache(I2CManager* i2c_manager, const char* bus_name);
+    ~BusTopologyCache();
+
+    esp_err_t discover(const uint8_t* expected_addresses, size_t expected_count);
+    bool contains(uint8_t device_address) const;
+    const DeviceMap& get_device_map() const { return device_map_; }
+    bool was_cache_hit() const { return cache_hit_; }
+    esp_err_t invalidate();
+
+private:
+    I2CManager* i2c_manager_;
+    const char* bus_name_;
+    DeviceMap device_map_;
+    bool cache_hit_;
+
+    static constexpr uint8_t CACHE_VERSION = 1;
+    static constexpr uint32_t VERIFY_PROBE_TIMEOUT_MS = 10;
+    static constexpr uint32_t SCAN_PROBE_TIMEOUT_MS = 5;
+    static constexpr uint8_t SCAN_FIRST_ADDRESS = 0x08;
+    static constexpr uint8_t SCAN_LAST_ADDRESS = 0x77;
+
+    esp_err_t load_cached_map(DeviceMap* map);
+    esp_err_t save_cached_map(const DeviceMap& map);
+    bool verify_map(const DeviceMap& map, const uint8_t* expected_addresses, size_t expected_count);
+    void scan_bus(DeviceMap* map, const uint8_t* expected_addresses, size_t expected_count);
+};
@@ -0,0 +1,148 @@
+#include "bus_topology.hpp"
+#include "esp_log.h"
+#include "nvs.h"
+#include <string.h>
+
+static const char *TAG = "BusTopology";
+static const char *NVS_NAMESPACE = "bus_topology";
+
+BusTopologyCache::BusTopologyCache(I2CManager* i2c_manager, const char* bus_name)
+    : i2c_manager_(i2c_manager), bus_name_(bus_name), device_map_{}, cache_hit_(false) {}
+
+BusTopologyCache::~BusTopologyCache() {}
+
+esp_err_t BusTopologyCache::discover(const uint8_t* expected_addresses, size_t expected_count) {
+    DeviceMap cached_map = {};
+    cache_hit_ = false;
+
+    if (load_cached_map(&cached_map) == ESP_OK &&
+        verify_map(cached_map, expected_addresses, expected_count)) {
+        device_map_ = cached_map;
+        cache_hit_ = true;
+        ESP_LOGI(TAG, "%s: topologia em cache confirmada (%d dispositivos)", bus_name_, device_map_.device_count);
+        return ESP_OK;
+    }
+
+    ESP_LOGW(TAG, "%s: cache ausente ou divergente, escaneando barramento", bus_name_);
+    scan_bus(&device_map_, expected_addresses, expected_count);
+
+    for (uint8_t i = 0; i < device_map_.device_count; i++) {
+        ESP_LOGI(TAG, "%s: dispositivo encontrado: 0x%02X", bus_name_, device_map_.addresses[i]);
+    }
+    ESP_LOGI(TAG, "%s: scan completo. Dispositivos encontrados: %d", bus_name_, device_map_.device_count);
+
+    esp_err_t save_result = save_cached_map(device_map_);
+    if (save_result != ESP_OK) {
+        ESP_LOGW(TAG, "%s: falha ao salvar topologia: %s", bus_name_, esp_err_to_name(save_result));
+    }
+
+    for (size_t i = 0; i < expected_count; i++) {
+        if (!contains(expected_addresses[i])) {
+            ESP_LOGW(TAG, "%s: dispositivo esperado 0x%02X ausente", bus_name_, expected_addresses[i]);
+            return ESP_ERR_NOT_FOUND;
+        }
+    }
+    return ESP_OK;
+}
+
+bool BusTopologyCache::contains(uint8_t device_address) const {
+    for (uint8_t i = 0; i < device_map_.device_count; i++) {
+        if (device_map_.addresses[i] == device_address) {
+            return true;
+        }
+    }
+    return false;
+}
+
+esp_err_t BusTopologyCache::invalidate() {
+    nvs_handle_t handle;
+    esp_err_t result = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    result = nvs_erase_key(handle, bus_name_);
+    if (result == ESP_OK) {
+        result = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return result;
+}
+
+esp_err_t BusTopologyCache::load_cached_map(DeviceMap* map) {
+    nvs_handle_t handle;
+    esp_err_t result = nvs_open(NVS_NAMESPACE, NVS_READONLY, &handle);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    size_t length = sizeof(DeviceMap);
+    result = nvs_get_blob(handle, bus_name_, map, &length);
+    nvs_close(handle);
+
+    if (result != ESP_OK) {
+        return result;
+    }
+    if (length != sizeof(DeviceMap) || map->version != CACHE_VERSION || map->device_count > MAX_CACHED_DEVICES) {
+        return ESP_ERR_INVALID_VERSION;
+    }
+    return ESP_OK;
+}
+
+esp_err_t BusTopologyCache::save_cached_map(const DeviceMap& map) {
+    nvs_handle_t handle;
+    esp_err_t result = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    result = nvs_set_blob(handle, bus_name_, &map, sizeof(DeviceMap));
+    if (result == ESP_OK) {
+        result = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return result;
+}
+
+// O cache vale se todos os endereços dele respondem e se contém todos os esperados
+bool BusTopologyCache::verify_map(const DeviceMap& map, const uint8_t* expected_addresses, size_t expected_count) {
+    for (size_t i = 0; i < expected_count; i++) {
+        bool cached = false;
+        for (uint8_t j = 0; j < map.device_count; j++) {
+            cached = cached || (map.addresses[j] == expected_addresses[i]);
+        }
+        if (!cached) {
+            return false;
+        }
+    }
+
+    for (uint8_t i = 0; i < map.device_count; i++) {
+        if (i2c_manager_->probe_device(map.addresses[i], VERIFY_PROBE_TIMEOUT_MS, false) != ESP_OK) {
+            ESP_LOGW(TAG, "%s: dispositivo 0x%02X do cache não responde", bus_name_, map.addresses[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+void BusTopologyCache::scan_bus(DeviceMap* map, const uint8_t* expected_addresses, size_t expected_count) {
+    memset(map, 0, sizeof(DeviceMap));
+    map->version = CACHE_VERSION;
+
+    for (uint8_t device_address = SCAN_FIRST_ADDRESS; device_address <= SCAN_LAST_ADDRESS; device_address++) {
+        if (i2c_manager_->scan_probe(device_address, SCAN_PROBE_TIMEOUT_MS) == ESP_OK &&
+            map->device_count < MAX_CACHED_DEVICES) {
+            map->addresses[map->device_count++] = device_address;
+        }
+    }
+
+    // Endereços esperados fora da faixa de scan (ex.: SMP3011 em 0x78) são sondados diretamente
+    for (size_t i = 0; i < expected_count; i++) {
+        uint8_t device_address = expected_addresses[i];
+        bool in_scan_range = device_address >= SCAN_FIRST_ADDRESS && device_address <= SCAN_LAST_ADDRESS;
+        if (!in_scan_range && map->device_count < MAX_CACHED_DEVICES &&
+            i2c_manager_->probe_device(device_address, SCAN_PROBE_TIMEOUT_MS, false) == ESP_OK) {
+            map->addresses[map->device_count++] = device_address;
+        }
+    }
+}
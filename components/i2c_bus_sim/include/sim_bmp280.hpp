@@ -0,0 +1,46 @@
+#pragma once
+#include "simulated_i2c_bus.hpp"
+
+// Modelo do BMP280: ID em 0xD0, reset em 0xE0, calibração em 0x88..0x9F,
+// status 0xF3, ctrl_meas 0xF4, config 0xF5 e dados em 0xF7..0xFC.
+// A calibração e as leituras brutas padrão são o exemplo do datasheet da Bosch
+// (adc_T = 519888, adc_P = 415148 -> 25.08 °C, 1006.53 hPa).
+class SimBMP280 : public SimulatedI2CDevice {
+public:
+    explicit SimBMP280(uint8_t device_address = 0x76);
+
+    void set_raw_measurement(int32_t raw_temperature, int32_t raw_pressure);
+    // Duração de uma conversão no modo forçado, µs; 0 = tempo típico do datasheet
+    // para o oversampling de ctrl_meas
+    void set_conversion_time_us(uint32_t conversion_time_us) { conversion_time_us_ = conversion_time_us; }
+    uint32_t get_conversions_started() const { return conversions_started_; }
+
+    void on_start(bool read) override;
+    void on_write(const uint8_t *data, size_t length) override;
+    void on_read(uint8_t *data, size_t length) override;
+
+private:
+    static constexpr uint8_t REGISTER_CALIBRATION_START = 0x88;
+    static constexpr uint8_t REGISTER_CHIP_ID = 0xD0;
+    static constexpr uint8_t REGISTER_RESET = 0xE0;
+    static constexpr uint8_t REGISTER_STATUS = 0xF3;
+    static constexpr uint8_t REGISTER_CONTROL_MEASUREMENT = 0xF4;
+    static constexpr uint8_t REGISTER_DATA_START = 0xF7;
+    static constexpr uint8_t STATUS_MEASURING = 0x08;
+
+    uint8_t registers_[256];
+    uint8_t register_pointer_;
+    bool pointer_pending_;
+    uint8_t pending_register_;
+    int32_t raw_temperature_;
+    int32_t raw_pressure_;
+    uint32_t conversion_time_us_;
+    int64_t conversion_end_us_;
+    uint32_t conversions_started_;
+
+    void reset_registers();
+    void write_register(uint8_t reg, uint8_t value);
+    void update_conversion_state();
+    uint32_t get_conversion_time_us() const;
+    void latch_measurement();
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include "simulated_i2c_bus.hpp"
+
+// Modelo do SMP3011 nos registradores usados pelo SMP3011Driver: dados 0x00..0x02
+// (20 bits, mesmo empacotamento do BMP280), status 0x07, controle 0x08 e WHO_AM_I 0x0F.
+// Escrever 0x01 no controle inicia uma conversão; o status indica ocupado até o fim.
+// Leituras são servidas de uma cópia travada no START, como os registradores sombra
+// do sensor: um burst nunca mistura bytes de duas conversões.
+class SimSMP3011 : public SimulatedI2CDevice {
+public:
+    static constexpr uint8_t STATUS_BUSY = 0x20;
+    static constexpr uint8_t STATUS_DATA_READY = 0x08;
+
+    explicit SimSMP3011(uint8_t device_address = 0x78);
+
+    void set_raw_pressure(uint32_t raw_pressure) { raw_pressure_ = raw_pressure & 0xFFFFF; }
+    // Ruído uniforme ±amplitude (contagens) somado a cada conversão
+    void set_noise_amplitude(uint32_t amplitude_counts) { noise_amplitude_ = amplitude_counts; }
+    void set_conversion_time_us(uint32_t conversion_time_us) { conversion_time_us_ = conversion_time_us; }
+    uint32_t get_conversions_started() const { return conversions_started_; }
+
+    void on_start(bool read) override;
+    void on_write(const uint8_t *data, size_t length) override;
+    void on_read(uint8_t *data, size_t length) override;
+    void on_stop() override;
+
+private:
+    static constexpr uint8_t REGISTER_DATA_MSB = 0x00;
+    static constexpr uint8_t REGISTER_STATUS = 0x07;
+    static constexpr uint8_t REGISTER_CONTROL = 0x08;
+    static constexpr uint8_t REGISTER_WHO_AM_I = 0x0F;
+    static constexpr uint8_t REGISTER_COUNT = 0x10;
+
+    uint8_t registers_[REGISTER_COUNT];
+    uint8_t shadow_registers_[REGISTER_COUNT];
+    bool data_consumed_;
+    uint8_t register_pointer_;
+    bool pointer_pending_;
+    uint32_t raw_pressure_;
+    uint32_t noise_amplitude_;
+    uint32_t noise_state_;
+    uint32_t conversion_time_us_;
+    int64_t conversion_end_us_;
+    uint32_t conversions_started_;
+
+    void update_conversion_state();
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include "simulated_i2c_bus.hpp"
+
+// Modelo do SSD1306 128x64: decodifica o fluxo de comandos (byte de controle 0x00/0x80)
+// e de dados (0x40/0xC0) para um framebuffer de 8 páginas x 128 colunas, respeitando os
+// modos de endereçamento horizontal, vertical e de página.
+// O scroll horizontal (0x26/0x27 + 0x2F) gira a GDDRAM das páginas configuradas uma
+// coluna a cada passo, pelo relógio (quadro de FRAME_PERIOD_US). Escrita de dados ou
+// configuração de scroll com ele ligado é proibida pelo datasheet e conta como violação.
+class SimSSD1306 : public SimulatedI2CDevice {
+public:
+    static constexpr uint8_t WIDTH = 128;
+    static constexpr uint8_t PAGES = 8;
+    static constexpr uint32_t FRAME_PERIOD_US = 9350;
+
+    struct DisplayStats {
+        uint32_t command_bytes;
+        uint32_t data_bytes;
+        uint32_t commands_decoded;
+        uint32_t scroll_steps;
+        uint32_t scroll_violations;
+    };
+
+    explicit SimSSD1306(uint8_t device_address = 0x3C);
+
+    const uint8_t *get_framebuffer() const { return &framebuffer_[0][0]; }
+    bool get_pixel(uint8_t x, uint8_t y) const;
+    bool is_display_on() const { return display_on_; }
+    bool is_scroll_active() const { return scroll_active_; }
+    // Aplica os passos de scroll vencidos até agora (chamado a cada transação)
+    void update_scroll();
+    DisplayStats get_stats() const { return stats_; }
+    void reset_stats() { stats_ = {}; }
+    void dump_ascii() const;
+
+    void on_start(bool read) override;
+    void on_write(const uint8_t *data, size_t length) override;
+    void on_read(uint8_t *data, size_t length) override;
+
+private:
+    enum class AddressingMode : uint8_t { HORIZONTAL = 0, VERTICAL = 1, PAGE = 2 };
+    enum class StreamState : uint8_t { CONTROL, COMMAND, DATA };
+
+    uint8_t framebuffer_[PAGES][WIDTH];
+    AddressingMode addressing_mode_;
+    uint8_t column_start_, column_end_, page_start_, page_end_;
+    uint8_t column_, page_;
+    bool display_on_;
+    bool scroll_active_;
+    bool scroll_left_;
+    uint8_t scroll_start_page_, scroll_end_page_;
+    uint16_t scroll_interval_frames_;
+    int64_t scroll_reference_us_;
+    int64_t scroll_steps_applied_;
+    StreamState stream_state_;
+    bool single_byte_control_;
+    uint8_t command_buffer_[8];
+    uint8_t command_length_;
+    DisplayStats stats_;
+
+    void handle_command_byte(uint8_t value);
+    void execute_command();
+    void write_data_byte(uint8_t value);
+    void rotate_scroll_pages(uint32_t steps);
+    static uint8_t command_argument_count(uint8_t command);
+};
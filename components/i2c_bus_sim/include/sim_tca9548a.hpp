@@ -0,0 +1,30 @@
+#pragma once
+#include "simulated_i2c_bus.hpp"
+
+// Modelo do multiplexador TCA9548A: um único registrador de controle (um bit por
+// canal). Os dispositivos dos canais não ficam no barramento; o barramento pede a
+// rota ao multiplexador e só enxerga os canais ligados. Dois canais ligados com o
+// mesmo endereço responderiam juntos no fio real; aqui vale o de menor índice.
+class SimTCA9548A : public SimulatedI2CDevice {
+public:
+    static constexpr size_t CHANNEL_COUNT = 8;
+
+    explicit SimTCA9548A(uint8_t device_address = 0x70);
+
+    esp_err_t attach_downstream(uint8_t channel, SimulatedI2CDevice *device);
+    uint8_t get_control() const { return control_; }
+    uint32_t get_control_writes() const { return control_writes_; }
+
+    SimulatedI2CDevice *route(uint8_t device_address) override;
+
+    void on_write(const uint8_t *data, size_t length) override;
+    void on_read(uint8_t *data, size_t length) override;
+
+private:
+    static constexpr size_t MAX_DEVICES_PER_CHANNEL = 4;
+
+    SimulatedI2CDevice *downstream_[CHANNEL_COUNT][MAX_DEVICES_PER_CHANNEL];
+    size_t downstream_count_[CHANNEL_COUNT];
+    uint8_t control_;
+    uint32_t control_writes_;
+};
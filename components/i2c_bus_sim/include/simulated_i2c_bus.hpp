@@ -0,0 +1,104 @@
+#pragma once
+#include "esp_err.h"
+#include "i2c_bus_backend.hpp"
+
+// Dispositivo modelado no nível de registradores. O barramento entrega cada transação
+// como on_start / on_write / on_read / on_stop, na mesma ordem em que os bytes iriam no fio.
+class SimulatedI2CDevice {
+public:
+    explicit SimulatedI2CDevice(uint8_t device_address);
+    virtual ~SimulatedI2CDevice() = default;
+
+    uint8_t get_address() const { return device_address_; }
+
+    // Tempo extra por byte (clock stretching, ns) somado ao tempo de fio do barramento
+    void set_extra_byte_time_ns(uint32_t extra_ns) { extra_byte_time_ns_ = extra_ns; }
+    uint32_t get_extra_byte_time_ns() const { return extra_byte_time_ns_; }
+
+    // Injeção de falhas: a cada N transações, nas próximas N, ou com probabilidade em %
+    void inject_nack_every(uint32_t period) { nack_period_ = period; }
+    void inject_timeout_every(uint32_t period) { timeout_period_ = period; }
+    void inject_next_failures(uint32_t count, esp_err_t error) { forced_failures_ = count; forced_error_ = error; }
+    void set_nack_probability(uint8_t percent) { nack_probability_percent_ = percent; }
+    // Acima deste clock o dispositivo não reconhece o endereço (tempo de subida marginal); 0 = sem limite
+    void set_max_clock_speed(uint32_t clock_speed) { max_clock_speed_ = clock_speed; }
+    void clear_faults();
+
+    // Chamado pelo barramento antes da transação; ESP_OK se o dispositivo vai responder
+    esp_err_t evaluate_fault(uint32_t clock_speed);
+
+    // Dispositivos que repassam transações (multiplexador) devolvem o modelo que
+    // responde ao endereço no estado atual; os demais não roteiam nada
+    virtual SimulatedI2CDevice *route(uint8_t device_address) { return nullptr; }
+
+    virtual void on_start(bool read) {}
+    virtual void on_write(const uint8_t *data, size_t length) {}
+    virtual void on_read(uint8_t *data, size_t length) {}
+    virtual void on_stop() {}
+
+private:
+    uint8_t device_address_;
+    uint32_t extra_byte_time_ns_;
+    uint32_t transaction_count_;
+    uint32_t nack_period_;
+    uint32_t timeout_period_;
+    uint32_t forced_failures_;
+    esp_err_t forced_error_;
+    uint8_t nack_probability_percent_;
+    uint32_t max_clock_speed_;
+    uint32_t random_state_;
+};
+
+// Barramento simulado: roteia transações para os modelos e contabiliza o tempo de fio
+// (9 bits por byte no clock configurado + START/STOP + overhead fixo por transação)
+class SimulatedI2CBus : public I2CBusBackend {
+public:
+    struct BusStats {
+        uint32_t transactions;
+        uint32_t nacks;
+        uint32_t timeouts;
+        uint32_t bytes_transferred;
+        uint32_t bus_clears;
+        // Transações em que mais de um dispositivo responderia ao endereço (ex.: um
+        // direto e outro num canal ligado do multiplexador)
+        uint32_t address_collisions;
+        uint64_t wire_time_ns;
+    };
+
+    SimulatedI2CBus();
+
+    esp_err_t attach_device(SimulatedI2CDevice *device);
+    SimulatedI2CDevice *find_device(uint8_t device_address);
+
+    // Overhead fixo por transação (driver + ISR no alvo real), em ns
+    void set_transaction_overhead_ns(uint32_t overhead_ns) { transaction_overhead_ns_ = overhead_ns; }
+    // Em tempo real cada transação ocupa de fato o tempo de fio calculado
+    void set_realtime(bool realtime) { realtime_ = realtime; }
+    // SDA presa em nível baixo: toda transação termina em timeout até um bus clear
+    void set_bus_stuck(bool stuck) { bus_stuck_ = stuck; }
+
+    uint32_t get_clock_speed() const { return clock_speed_; }
+    BusStats get_stats() const { return stats_; }
+    void reset_stats() { stats_ = {}; }
+
+    esp_err_t configure(uint32_t clk_speed) override;
+    esp_err_t transfer(uint8_t device_addr, const I2CManager::WriteSegment *segments, size_t segment_count,
+                       uint8_t *read_data, size_t read_len) override;
+    bool is_sda_stuck() override { return bus_stuck_; }
+    esp_err_t clear_bus() override;
+
+private:
+    static constexpr size_t MAX_DEVICES = 24;
+    static constexpr uint32_t TIMEOUT_WIRE_TIME_NS = 1000000; // tempo perdido num timeout simulado
+
+    SimulatedI2CDevice *devices_[MAX_DEVICES];
+    size_t device_count_;
+    uint32_t clock_speed_;
+    uint32_t transaction_overhead_ns_;
+    bool realtime_;
+    bool bus_stuck_;
+    BusStats stats_;
+
+    void account_wire_time(uint64_t wire_time_ns);
+    size_t count_responders(uint8_t device_address);
+};
@@ -0,0 +1,133 @@
+#include "sim_bmp280.hpp"
+#include "esp_timer.h"
+#include <string.h>
+
+// Coeficientes de exemplo do datasheet (dig_T1..dig_T3, dig_P1..dig_P9), little endian
+static const uint8_t DATASHEET_CALIBRATION[24] = {
+    0x70, 0x6B, // T1 = 27504
+    0x43, 0x67, // T2 = 26435
+    0x18, 0xFC, // T3 = -1000
+    0x7D, 0x8E, // P1 = 36477
+    0x43, 0xD6, // P2 = -10685
+    0xD0, 0x0B, // P3 = 3024
+    0x27, 0x0B, // P4 = 2855
+    0x8C, 0x00, // P5 = 140
+    0xF9, 0xFF, // P6 = -7
+    0x8C, 0x3C, // P7 = 15500
+    0xF8, 0xC6, // P8 = -14600
+    0x70, 0x17, // P9 = 6000
+};
+
+SimBMP280::SimBMP280(uint8_t device_address)
+    : SimulatedI2CDevice(device_address), register_pointer_(0), pointer_pending_(false), pending_register_(0),
+      raw_temperature_(519888), raw_pressure_(415148), conversion_time_us_(0), conversion_end_us_(0),
+      conversions_started_(0) {
+    reset_registers();
+}
+
+void SimBMP280::reset_registers() {
+    memset(registers_, 0, sizeof(registers_));
+    memcpy(&registers_[REGISTER_CALIBRATION_START], DATASHEET_CALIBRATION, sizeof(DATASHEET_CALIBRATION));
+    registers_[REGISTER_CHIP_ID] = 0x58;
+    // Dados após reset: 0x80000 em ambos os canais (valor "sem medição" do datasheet)
+    registers_[REGISTER_DATA_START + 0] = 0x80;
+    registers_[REGISTER_DATA_START + 3] = 0x80;
+    conversion_end_us_ = 0;
+}
+
+void SimBMP280::set_raw_measurement(int32_t raw_temperature, int32_t raw_pressure) {
+    raw_temperature_ = raw_temperature & 0xFFFFF;
+    raw_pressure_ = raw_pressure & 0xFFFFF;
+
+    // No modo normal os registradores de dados acompanham a medição continuamente
+    if ((registers_[REGISTER_CONTROL_MEASUREMENT] & 0x03) == 0x03) {
+        latch_measurement();
+    }
+}
+
+void SimBMP280::latch_measurement() {
+    registers_[REGISTER_DATA_START + 0] = (raw_pressure_ >> 12) & 0xFF;
+    registers_[REGISTER_DATA_START + 1] = (raw_pressure_ >> 4) & 0xFF;
+    registers_[REGISTER_DATA_START + 2] = (raw_pressure_ << 4) & 0xF0;
+    registers_[REGISTER_DATA_START + 3] = (raw_temperature_ >> 12) & 0xFF;
+    registers_[REGISTER_DATA_START + 4] = (raw_temperature_ >> 4) & 0xFF;
+    registers_[REGISTER_DATA_START + 5] = (raw_temperature_ << 4) & 0xF0;
+}
+
+void SimBMP280::update_conversion_state() {
+    if (conversion_end_us_ != 0 && esp_timer_get_time() >= conversion_end_us_) {
+        conversion_end_us_ = 0;
+        registers_[REGISTER_STATUS] &= ~STATUS_MEASURING;
+        latch_measurement();
+        // Modo forçado volta para sleep ao fim da conversão
+        if ((registers_[REGISTER_CONTROL_MEASUREMENT] & 0x03) != 0x03) {
+            registers_[REGISTER_CONTROL_MEASUREMENT] &= ~0x03;
+        }
+    }
+}
+
+void SimBMP280::write_register(uint8_t reg, uint8_t value) {
+    if (reg == REGISTER_RESET) {
+        if (value == 0xB6) {
+            reset_registers();
+        }
+        return;
+    }
+
+    // Calibração, ID e dados são somente leitura
+    if (reg == REGISTER_CONTROL_MEASUREMENT || reg == 0xF5) {
+        registers_[reg] = value;
+    }
+
+    if (reg == REGISTER_CONTROL_MEASUREMENT) {
+        uint8_t mode = value & 0x03;
+        if (mode == 0x01 || mode == 0x02) {
+            // Modo forçado: uma conversão
+            conversions_started_++;
+            registers_[REGISTER_STATUS] |= STATUS_MEASURING;
+            conversion_end_us_ = esp_timer_get_time() + get_conversion_time_us();
+        } else if (mode == 0x03) {
+            latch_measurement();
+        }
+    }
+}
+
+uint32_t SimBMP280::get_conversion_time_us() const {
+    if (conversion_time_us_ > 0) {
+        return conversion_time_us_;
+    }
+
+    // Típico: 1 ms + 2 ms por amostra de T e de P + 0,5 ms com P
+    static const uint8_t SAMPLES[] = {0, 1, 2, 4, 8, 16, 16, 16};
+    uint8_t control = registers_[REGISTER_CONTROL_MEASUREMENT];
+    uint32_t temperature_samples = SAMPLES[(control >> 5) & 0x07];
+    uint32_t pressure_samples = SAMPLES[(control >> 2) & 0x07];
+    return 1000 + 2000 * temperature_samples + 2000 * pressure_samples + ((pressure_samples > 0) ? 500 : 0);
+}
+
+void SimBMP280::on_start(bool read) {
+    if (!read) {
+        pointer_pending_ = true;
+    }
+}
+
+void SimBMP280::on_write(const uint8_t *data, size_t length) {
+    // Escrita no BMP280 é uma sequência de pares (registrador, valor)
+    for (size_t i = 0; i < length; i++) {
+        if (pointer_pending_) {
+            pending_register_ = data[i];
+            register_pointer_ = data[i];
+            pointer_pending_ = false;
+        } else {
+            write_register(pending_register_, data[i]);
+            pointer_pending_ = true;
+        }
+    }
+}
+
+void SimBMP280::on_read(uint8_t *data, size_t length) {
+    update_conversion_state();
+    for (size_t i = 0; i < length; i++) {
+        data[i] = registers_[register_pointer_++];
+    }
+}
@@ -0,0 +1,80 @@
+#include "sim_smp3011.hpp"
+#include "esp_timer.h"
+#include <string.h>
+
+SimSMP3011::SimSMP3011(uint8_t device_address)
+    : SimulatedI2CDevice(device_address), data_consumed_(false), register_pointer_(0), pointer_pending_(false),
+      raw_pressure_(167772), noise_amplitude_(0), noise_state_(0xACE1u), conversion_time_us_(10000),
+      conversion_end_us_(0), conversions_started_(0) {
+    memset(registers_, 0, sizeof(registers_));
+    memset(shadow_registers_, 0, sizeof(shadow_registers_));
+    registers_[REGISTER_WHO_AM_I] = 0x30;
+}
+
+void SimSMP3011::update_conversion_state() {
+    if (conversion_end_us_ == 0 || esp_timer_get_time() < conversion_end_us_) {
+        return;
+    }
+    conversion_end_us_ = 0;
+
+    uint32_t sample = raw_pressure_;
+    if (noise_amplitude_ > 0) {
+        noise_state_ = noise_state_ * 1664525u + 1013904223u;
+        int32_t noise = (int32_t)((noise_state_ >> 8) % (2 * noise_amplitude_ + 1)) - (int32_t)noise_amplitude_;
+        int32_t noisy = (int32_t)sample + noise;
+        sample = (noisy < 0) ? 0 : ((noisy > 0xFFFFF) ? 0xFFFFF : (uint32_t)noisy);
+    }
+
+    registers_[REGISTER_DATA_MSB + 0] = (sample >> 12) & 0xFF;
+    registers_[REGISTER_DATA_MSB + 1] = (sample >> 4) & 0xFF;
+    registers_[REGISTER_DATA_MSB + 2] = (sample << 4) & 0xF0;
+    registers_[REGISTER_STATUS] = STATUS_DATA_READY;
+}
+
+void SimSMP3011::on_start(bool read) {
+    if (!read) {
+        pointer_pending_ = true;
+        return;
+    }
+
+    update_conversion_state();
+    memcpy(shadow_registers_, registers_, sizeof(registers_));
+}
+
+void SimSMP3011::on_write(const uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (pointer_pending_) {
+            register_pointer_ = data[i] % REGISTER_COUNT;
+            pointer_pending_ = false;
+            continue;
+        }
+
+        if (register_pointer_ == REGISTER_CONTROL && (data[i] & 0x01)) {
+            conversions_started_++;
+            registers_[REGISTER_STATUS] = STATUS_BUSY;
+            conversion_end_us_ = esp_timer_get_time() + conversion_time_us_;
+        }
+        if (register_pointer_ == REGISTER_CONTROL) {
+            registers_[REGISTER_CONTROL] = data[i];
+        }
+        register_pointer_ = (register_pointer_ + 1) % REGISTER_COUNT;
+    }
+}
+
+void SimSMP3011::on_read(uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        data[i] = shadow_registers_[register_pointer_];
+        if (register_pointer_ <= REGISTER_DATA_MSB + 2) {
+            data_consumed_ = true;
+        }
+        register_pointer_ = (register_pointer_ + 1) % REGISTER_COUNT;
+    }
+}
+
+void SimSMP3011::on_stop() {
+    // Leitura dos dados consome a amostra nova
+    if (data_consumed_) {
+        registers_[REGISTER_STATUS] &= ~STATUS_DATA_READY;
+        data_consumed_ = false;
+    }
+}
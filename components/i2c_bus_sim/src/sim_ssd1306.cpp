@@ -0,0 +1,213 @@
+#include "sim_ssd1306.hpp"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <string.h>
+
+static const char *TAG = "SimSSD1306";
+
+// Quadros por passo de scroll, pelo código de intervalo (bits 2:0)
+static const uint16_t SCROLL_INTERVAL_FRAMES[8] = {5, 64, 128, 256, 3, 4, 25, 2};
+
+SimSSD1306::SimSSD1306(uint8_t device_address)
+    : SimulatedI2CDevice(device_address), addressing_mode_(AddressingMode::PAGE),
+      column_start_(0), column_end_(WIDTH - 1), page_start_(0), page_end_(PAGES - 1),
+      column_(0), page_(0), display_on_(false), scroll_active_(false), scroll_left_(false),
+      scroll_start_page_(0), scroll_end_page_(PAGES - 1), scroll_interval_frames_(SCROLL_INTERVAL_FRAMES[0]),
+      scroll_reference_us_(0), scroll_steps_applied_(0),
+      stream_state_(StreamState::CONTROL), single_byte_control_(false), command_length_(0), stats_{} {
+    memset(framebuffer_, 0, sizeof(framebuffer_));
+}
+
+bool SimSSD1306::get_pixel(uint8_t x, uint8_t y) const {
+    if (x >= WIDTH || y >= PAGES * 8) {
+        return false;
+    }
+    return (framebuffer_[y / 8][x] >> (y % 8)) & 0x01;
+}
+
+void SimSSD1306::dump_ascii() const {
+    char line[WIDTH + 1];
+    for (uint8_t y = 0; y < PAGES * 8; y++) {
+        for (uint8_t x = 0; x < WIDTH; x++) {
+            line[x] = get_pixel(x, y) ? '#' : '.';
+        }
+        line[WIDTH] = '\0';
+        ESP_LOGI(TAG, "%s", line);
+    }
+}
+
+void SimSSD1306::update_scroll() {
+    if (!scroll_active_) {
+        return;
+    }
+
+    int64_t steps = (esp_timer_get_time() - scroll_reference_us_) / ((int64_t)scroll_interval_frames_ * FRAME_PERIOD_US);
+    if (steps > scroll_steps_applied_) {
+        rotate_scroll_pages((uint32_t)(steps - scroll_steps_applied_));
+        stats_.scroll_steps += (uint32_t)(steps - scroll_steps_applied_);
+        scroll_steps_applied_ = steps;
+    }
+}
+
+// Scroll para a esquerda leva a coluna 0 para a 127; para a direita, o contrário
+void SimSSD1306::rotate_scroll_pages(uint32_t steps) {
+    const uint8_t shift = scroll_left_ ? (steps % WIDTH) : ((WIDTH - steps % WIDTH) % WIDTH);
+    uint8_t rotated[WIDTH];
+
+    for (uint8_t page = scroll_start_page_; page <= scroll_end_page_ && page < PAGES; page++) {
+        memcpy(rotated, &framebuffer_[page][shift], WIDTH - shift);
+        memcpy(&rotated[WIDTH - shift], framebuffer_[page], shift);
+        memcpy(framebuffer_[page], rotated, WIDTH);
+    }
+}
+
+void SimSSD1306::on_start(bool read) {
+    update_scroll();
+    stream_state_ = StreamState::CONTROL;
+    single_byte_control_ = false;
+}
+
+void SimSSD1306::on_read(uint8_t *data, size_t length) {
+    // Status: bit 6 = display desligado
+    memset(data, display_on_ ? 0x00 : 0x40, length);
+}
+
+void SimSSD1306::on_write(const uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        uint8_t value = data[i];
+
+        if (stream_state_ == StreamState::CONTROL) {
+            // Co (bit 7) = 1: apenas um byte segue antes do próximo byte de controle
+            single_byte_control_ = (value & 0x80) != 0;
+            stream_state_ = (value & 0x40) ? StreamState::DATA : StreamState::COMMAND;
+            continue;
+        }
+
+        if (stream_state_ == StreamState::DATA) {
+            stats_.data_bytes++;
+            if (scroll_active_) {
+                stats_.scroll_violations++;
+            }
+            write_data_byte(value);
+        } else {
+            stats_.command_bytes++;
+            handle_command_byte(value);
+        }
+
+        if (single_byte_control_) {
+            stream_state_ = StreamState::CONTROL;
+        }
+    }
+}
+
+uint8_t SimSSD1306::command_argument_count(uint8_t command) {
+    switch (command) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5:
+        case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+void SimSSD1306::handle_command_byte(uint8_t value) {
+    command_buffer_[command_length_++] = value;
+    if (command_length_ > command_argument_count(command_buffer_[0])) {
+        execute_command();
+        command_length_ = 0;
+    }
+}
+
+void SimSSD1306::execute_command() {
+    uint8_t command = command_buffer_[0];
+    stats_.commands_decoded++;
+
+    if (command <= 0x0F) {
+        column_ = (column_ & 0xF0) | command;               // Coluna baixa (modo página)
+    } else if (command <= 0x1F) {
+        column_ = (column_ & 0x0F) | ((command & 0x0F) << 4); // Coluna alta (modo página)
+    } else if (command >= 0xB0 && command <= 0xB7) {
+        page_ = command & 0x07;                                // Página (modo página)
+    } else {
+        switch (command) {
+            case 0x20:
+                addressing_mode_ = static_cast<AddressingMode>(command_buffer_[1] & 0x03);
+                break;
+            case 0x21:
+                column_start_ = command_buffer_[1] & 0x7F;
+                column_end_ = command_buffer_[2] & 0x7F;
+                column_ = column_start_;
+                break;
+            case 0x22:
+                page_start_ = command_buffer_[1] & 0x07;
+                page_end_ = command_buffer_[2] & 0x07;
+                page_ = page_start_;
+                break;
+            case 0x26:
+            case 0x27:
+                if (scroll_active_) {
+                    stats_.scroll_violations++;
+                }
+                scroll_left_ = (command == 0x27);
+                scroll_start_page_ = command_buffer_[2] & 0x07;
+                scroll_interval_frames_ = SCROLL_INTERVAL_FRAMES[command_buffer_[3] & 0x07];
+                scroll_end_page_ = command_buffer_[4] & 0x07;
+                break;
+            case 0x2E:
+                update_scroll();
+                scroll_active_ = false;
+                break;
+            case 0x2F:
+                if (!scroll_active_) {
+                    scroll_active_ = true;
+                    scroll_reference_us_ = esp_timer_get_time();
+                    scroll_steps_applied_ = 0;
+                }
+                break;
+            case 0xAE:
+                display_on_ = false;
+                break;
+            case 0xAF:
+                display_on_ = true;
+                break;
+            default:
+                // Comandos de configuração de hardware não alteram o framebuffer
+                break;
+        }
+    }
+}
+
+void SimSSD1306::write_data_byte(uint8_t value) {
+    framebuffer_[page_ & 0x07][column_ & 0x7F] = value;
+
+    switch (addressing_mode_) {
+        case AddressingMode::HORIZONTAL:
+            if (column_ >= column_end_) {
+                column_ = column_start_;
+                page_ = (page_ >= page_end_) ? page_start_ : page_ + 1;
+            } else {
+                column_++;
+            }
+            break;
+        case AddressingMode::VERTICAL:
+            if (page_ >= page_end_) {
+                page_ = page_start_;
+                column_ = (column_ >= column_end_) ? column_start_ : column_ + 1;
+            } else {
+                page_++;
+            }
+            break;
+        case AddressingMode::PAGE:
+        default:
+            if (column_ < WIDTH - 1) {
+                column_++;
+            }
+            break;
+    }
+}
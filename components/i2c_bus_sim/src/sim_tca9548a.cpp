@@ -0,0 +1,46 @@
+#include "sim_tca9548a.hpp"
+
+SimTCA9548A::SimTCA9548A(uint8_t device_address)
+    : SimulatedI2CDevice(device_address), downstream_{}, downstream_count_{}, control_(0), control_writes_(0) {}
+
+esp_err_t SimTCA9548A::attach_downstream(uint8_t channel, SimulatedI2CDevice *device) {
+    if (channel >= CHANNEL_COUNT || device == nullptr || downstream_count_[channel] >= MAX_DEVICES_PER_CHANNEL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    downstream_[channel][downstream_count_[channel]++] = device;
+    return ESP_OK;
+}
+
+SimulatedI2CDevice *SimTCA9548A::route(uint8_t device_address) {
+    for (size_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+        if ((control_ & (1u << channel)) == 0) {
+            continue;
+        }
+        for (size_t i = 0; i < downstream_count_[channel]; i++) {
+            if (downstream_[channel][i]->get_address() == device_address) {
+                return downstream_[channel][i];
+            }
+            // Multiplexador em cascata num canal ligado
+            SimulatedI2CDevice *nested = downstream_[channel][i]->route(device_address);
+            if (nested != nullptr) {
+                return nested;
+            }
+        }
+    }
+    return nullptr;
+}
+
+// Toda escrita é o byte de controle; o último byte de um burst prevalece
+void SimTCA9548A::on_write(const uint8_t *data, size_t length) {
+    if (length > 0) {
+        control_ = data[length - 1];
+        control_writes_++;
+    }
+}
+
+void SimTCA9548A::on_read(uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        data[i] = control_;
+    }
+}
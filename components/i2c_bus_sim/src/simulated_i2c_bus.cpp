@@ -0,0 +1,178 @@
+#include "simulated_i2c_bus.hpp"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "SimulatedI2CBus";
+
+SimulatedI2CDevice::SimulatedI2CDevice(uint8_t device_address)
+    : device_address_(device_address), extra_byte_time_ns_(0), transaction_count_(0),
+      nack_period_(0), timeout_period_(0), forced_failures_(0), forced_error_(ESP_FAIL),
+      nack_probability_percent_(0), max_clock_speed_(0), random_state_(0x12345678u ^ device_address) {}
+
+void SimulatedI2CDevice::clear_faults() {
+    nack_period_ = 0;
+    timeout_period_ = 0;
+    forced_failures_ = 0;
+    nack_probability_percent_ = 0;
+    max_clock_speed_ = 0;
+}
+
+esp_err_t SimulatedI2CDevice::evaluate_fault(uint32_t clock_speed) {
+    transaction_count_++;
+
+    if (max_clock_speed_ > 0 && clock_speed > max_clock_speed_) {
+        return ESP_FAIL;
+    }
+
+    if (forced_failures_ > 0) {
+        forced_failures_--;
+        return forced_error_;
+    }
+    if (timeout_period_ > 0 && transaction_count_ % timeout_period_ == 0) {
+        return ESP_ERR_TIMEOUT;
+    }
+    if (nack_period_ > 0 && transaction_count_ % nack_period_ == 0) {
+        return ESP_FAIL;
+    }
+    if (nack_probability_percent_ > 0) {
+        // LCG simples: determinístico entre execuções
+        random_state_ = random_state_ * 1664525u + 1013904223u;
+        if ((random_state_ >> 16) % 100 < nack_probability_percent_) {
+            return ESP_FAIL;
+        }
+    }
+    return ESP_OK;
+}
+
+SimulatedI2CBus::SimulatedI2CBus()
+    : devices_{}, device_count_(0), clock_speed_(100000), transaction_overhead_ns_(0),
+      realtime_(false), bus_stuck_(false), stats_{} {}
+
+esp_err_t SimulatedI2CBus::attach_device(SimulatedI2CDevice *device) {
+    if (device == nullptr || device_count_ >= MAX_DEVICES) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (find_device(device->get_address()) != nullptr) {
+        ESP_LOGE(TAG, "Endereço 0x%02X já ocupado no barramento simulado", device->get_address());
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    devices_[device_count_++] = device;
+    return ESP_OK;
+}
+
+SimulatedI2CDevice *SimulatedI2CBus::find_device(uint8_t device_address) {
+    for (size_t i = 0; i < device_count_; i++) {
+        if (devices_[i]->get_address() == device_address) {
+            return devices_[i];
+        }
+    }
+
+    // Dispositivos atrás de um multiplexador, nos canais ligados
+    for (size_t i = 0; i < device_count_; i++) {
+        SimulatedI2CDevice *routed = devices_[i]->route(device_address);
+        if (routed != nullptr) {
+            return routed;
+        }
+    }
+    return nullptr;
+}
+
+size_t SimulatedI2CBus::count_responders(uint8_t device_address) {
+    size_t responders = 0;
+    for (size_t i = 0; i < device_count_; i++) {
+        if (devices_[i]->get_address() == device_address) {
+            responders++;
+        }
+        if (devices_[i]->route(device_address) != nullptr) {
+            responders++;
+        }
+    }
+    return responders;
+}
+
+esp_err_t SimulatedI2CBus::configure(uint32_t clk_speed) {
+    if (clk_speed == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    clock_speed_ = clk_speed;
+    ESP_LOGI(TAG, "Barramento simulado a %lu Hz", (unsigned long)clk_speed);
+    return ESP_OK;
+}
+
+esp_err_t SimulatedI2CBus::transfer(uint8_t device_addr, const I2CManager::WriteSegment *segments,
+                                    size_t segment_count, uint8_t *read_data, size_t read_len) {
+    const uint64_t bit_time_ns = 1000000000ull / clock_speed_;
+    stats_.transactions++;
+
+    if (bus_stuck_) {
+        stats_.timeouts++;
+        account_wire_time(TIMEOUT_WIRE_TIME_NS);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    SimulatedI2CDevice *device = find_device(device_addr);
+    if (device != nullptr && count_responders(device_addr) > 1) {
+        stats_.address_collisions++;
+    }
+    esp_err_t fault = (device != nullptr) ? device->evaluate_fault(clock_speed_) : ESP_FAIL;
+    if (fault != ESP_OK) {
+        // NACK no byte de endereço: START + endereço + STOP
+        if (fault == ESP_ERR_TIMEOUT) {
+            stats_.timeouts++;
+            account_wire_time(TIMEOUT_WIRE_TIME_NS);
+        } else {
+            stats_.nacks++;
+            account_wire_time(transaction_overhead_ns_ + bit_time_ns * (9 + 2));
+        }
+        return fault;
+    }
+
+    size_t bytes_written = 0;
+    bool has_write_phase = segment_count > 0 || read_len == 0;
+    if (has_write_phase) {
+        device->on_start(false);
+        for (size_t i = 0; i < segment_count; i++) {
+            if (segments[i].length > 0) {
+                device->on_write(segments[i].data, segments[i].length);
+                bytes_written += segments[i].length;
+            }
+        }
+    }
+
+    if (read_len > 0) {
+        device->on_start(true);
+        device->on_read(read_data, read_len);
+    }
+    device->on_stop();
+
+    // Bytes de endereço: um por fase; START/STOP (e repeated START) contam como ~1 bit cada
+    size_t address_bytes = (has_write_phase ? 1 : 0) + (read_len > 0 ? 1 : 0);
+    size_t wire_bytes = address_bytes + bytes_written + read_len;
+    uint64_t wire_time_ns = transaction_overhead_ns_ + bit_time_ns * (9 * wire_bytes + address_bytes + 1)
+                            + (uint64_t)device->get_extra_byte_time_ns() * wire_bytes;
+
+    stats_.bytes_transferred += bytes_written + read_len;
+    account_wire_time(wire_time_ns);
+    return ESP_OK;
+}
+
+// Os 9 pulsos de SCL liberam o escravo que segurava SDA
+esp_err_t SimulatedI2CBus::clear_bus() {
+    const uint64_t bit_time_ns = 1000000000ull / clock_speed_;
+    stats_.bus_clears++;
+    bus_stuck_ = false;
+    account_wire_time(bit_time_ns * (9 + 1));
+    return ESP_OK;
+}
+
+void SimulatedI2CBus::account_wire_time(uint64_t wire_time_ns) {
+    stats_.wire_time_ns += wire_time_ns;
+
+    if (realtime_) {
+        int64_t end_us = esp_timer_get_time() + (int64_t)(wire_time_ns / 1000);
+        while (esp_timer_get_time() < end_us) {
+        }
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "esp_err.h"
+#include "i2c_manager.hpp"
+
+// Interface de barramento usada pelo I2CManager no lugar do driver do ESP-IDF.
+// transfer() recebe a transação completa (START ... STOP) já com o bus_mutex_ tomado.
+class I2CBusBackend {
+public:
+    virtual ~I2CBusBackend() = default;
+
+    virtual esp_err_t configure(uint32_t clk_speed) = 0;
+    virtual esp_err_t transfer(uint8_t device_addr, const I2CManager::WriteSegment *segments, size_t segment_count,
+                               uint8_t *read_data, size_t read_len) = 0;
+
+    // Recuperação de SDA presa; backends sem esse modo de falha mantêm o padrão
+    virtual bool is_sda_stuck() { return false; }
+    virtual esp_err_t clear_bus() { return ESP_ERR_NOT_SUPPORTED; }
+};
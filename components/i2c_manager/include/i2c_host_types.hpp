@@ -0,0 +1,12 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Tipos mínimos do driver I2C para o target linux (host), onde driver/i2c.h não existe.
+// Nesse target o I2CManager só opera com um I2CBusBackend anexado.
+typedef int i2c_port_t;
+typedef int gpio_num_t;
+
+#define I2C_NUM_0 0
+#define I2C_NUM_1 1
+#define GPIO_NUM_NC -1
@@ -1,21 +1,310 @@
 #pragma once
+#include "sdkconfig.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include "i2c_host_types.hpp"
+#else
 #include "driver/i2c.h"
+#endif
 #include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+class I2CBusBackend;
 
 class I2CManager {
 public:
+    // Trecho de dados de uma escrita scatter-gather
+    struct WriteSegment {
+        const uint8_t* data;
+        size_t length;
+    };
+
+    // Contadores do caminho de transação (prova de zero alocação por transferência)
+    struct TransferCounters {
+        uint32_t transactions;
+        uint32_t heap_allocations;
+        uint32_t static_buffer_overflows;
+        uint32_t bus_clears;
+    };
+
+    static constexpr size_t MAX_WRITE_SEGMENTS = 4;
+    static constexpr uint32_t DEFAULT_TRANSFER_TIMEOUT_MS = 1000;
+
+    // Deadline automático (timeout_ms = 0): tempo de fio esperado no clock atual,
+    // multiplicado pela folga, mais uma margem fixa para o driver
+    static constexpr uint32_t DEADLINE_SLACK_FACTOR = 4;
+    static constexpr uint32_t DEADLINE_MARGIN_MS = 5;
+    static constexpr TickType_t MIN_DEADLINE_TICKS = 2;
+
+    // Histograma de latência com limites fixos (µs); o último bucket é aberto
+    static constexpr size_t LATENCY_BUCKET_COUNT = 8;
+    static constexpr uint32_t LATENCY_BUCKET_LIMITS_US[LATENCY_BUCKET_COUNT - 1] = {
+        100, 200, 500, 1000, 2000, 5000, 10000
+    };
+
+    // Telemetria por endereço
+    struct DeviceStats {
+        uint8_t device_addr;
+        uint32_t transactions;
+        uint32_t bytes_written;
+        uint32_t bytes_read;
+        uint32_t nacks;
+        uint32_t timeouts;
+        uint32_t bus_busy_retries;
+        uint32_t breaker_trips;
+        uint32_t fast_failures;
+        uint32_t latency_histogram[LATENCY_BUCKET_COUNT];
+        uint32_t max_latency_us;
+    };
+
+    // Classes de prioridade do árbitro do barramento (menor valor = maior prioridade)
+    enum class BusPriority : uint8_t {
+        SENSOR_ACQUISITION = 0,
+        USER_FEEDBACK = 1,
+        DISPLAY_FLUSH = 2,
+    };
+    static constexpr size_t PRIORITY_CLASS_COUNT = 3;
+
+    // Estatísticas do árbitro: espera da fila até o início da execução, por classe
+    struct ArbitrationStats {
+        uint32_t requests[PRIORITY_CLASS_COUNT];
+        int64_t max_wait_us[PRIORITY_CLASS_COUNT];
+        int64_t max_chunk_us;
+        uint32_t chunks_executed;
+    };
+
+    // Velocidades padrão do barramento
+    enum class BusSpeed : uint32_t {
+        STANDARD = 100000,
+        FAST = 400000,
+        FAST_PLUS = 1000000,
+    };
+
+    // Política do fallback automático de clock: desce um nível quando error_threshold
+    // NACKs/timeouts ocorrem dentro de window_transactions transações, e sobe um nível
+    // depois de quiet_period_ms sem erros
+    struct SpeedPolicy {
+        uint32_t window_transactions;
+        uint32_t error_threshold;
+        uint32_t quiet_period_ms;
+    };
+
+    struct SpeedStats {
+        uint32_t clock_speed;
+        uint32_t target_speed;
+        uint32_t step_downs;
+        uint32_t step_ups;
+    };
+
+    // Como uma transação entra no registro por endereço (estatísticas e disjuntor)
+    enum class DeviceAccounting : uint8_t {
+        // Cria o registro na primeira transação, com sucesso ou falha: um dispositivo
+        // ausente desde o boot também ganha contadores e disjuntor
+        TRACKED,
+        // Scan: endereço que não responde não ocupa slot
+        SCAN,
+        // Repasse de um barramento virtual (canal de multiplexador): sem registro e
+        // sem disjuntor no pai; o barramento virtual tem os próprios
+        UNTRACKED,
+    };
+
+    // Callback de conclusão; executado no contexto da task de trabalho do barramento
+    using CompletionCallback = void (*)(esp_err_t result, void *context);
+
+    // Requisição assíncrona. Os buffers apontados pelos segmentos e por read_data
+    // precisam continuar válidos até o callback ser chamado.
+    struct AsyncRequest {
+        uint8_t device_addr;
+        WriteSegment segments[MAX_WRITE_SEGMENTS];
+        size_t segment_count;
+        uint8_t *read_data;
+        size_t read_len;
+        CompletionCallback on_complete;
+        void *context;
+        BusPriority priority;
+        // Escrita sem leitura cujo segments[0] (byte de controle/registrador) pode ser
+        // repetido a cada pedaço, permitindo dividir o payload em pedaços limitados
+        bool splittable;
+        // Timeout da transação no driver; 0 = deadline pelo tamanho da transação
+        uint32_t timeout_ms;
+        DeviceAccounting accounting;
+        int64_t enqueue_time_us;
+    };
+
     I2CManager(i2c_port_t port);
     ~I2CManager();
 
+    // Backend alternativo ao driver do ESP-IDF (ex.: barramento simulado); chamar antes de initialize()
+    esp_err_t attach_backend(I2CBusBackend *backend);
+    // clk_speed é o teto do barramento; o clock efetivo é o menor entre ele e o
+    // limite declarado por cada dispositivo em set_device_max_speed()
     esp_err_t initialize(gpio_num_t sda, gpio_num_t scl, uint32_t clk_speed = 100000);
     esp_err_t probe_device(uint8_t device_addr);
+    esp_err_t probe_device(uint8_t device_addr, uint32_t timeout_ms, bool log_found = true);
+    // Sonda de scan: só um endereço que responde entra no registro de dispositivos
+    esp_err_t scan_probe(uint8_t device_addr, uint32_t timeout_ms);
     esp_err_t write_register(uint8_t device_addr, uint8_t reg_addr, uint8_t data);
+    esp_err_t write_register_block(uint8_t device_addr, uint8_t reg_addr, const uint8_t *data, size_t len);
+    esp_err_t write_bytes(uint8_t device_addr, const uint8_t *data, size_t len);
+    esp_err_t write_segments(uint8_t device_addr, const WriteSegment *segments, size_t segment_count);
     esp_err_t read_register(uint8_t device_addr, uint8_t reg_addr, uint8_t *data, size_t len);
+    // Transação genérica (escrita dos segmentos + leitura opcional)
+    esp_err_t transfer(uint8_t device_addr, const WriteSegment *segments, size_t segment_count,
+                       uint8_t *read_data, size_t read_len);
+    // Mesma transação repassada por um barramento virtual atrás de um multiplexador:
+    // dispositivos em canais diferentes dividem o endereço, então o pai não mantém
+    // registro nem disjuntor para ele (DeviceAccounting::UNTRACKED)
+    esp_err_t forward_transfer(uint8_t device_addr, const WriteSegment *segments, size_t segment_count,
+                               uint8_t *read_data, size_t read_len);
+
+    // Motor assíncrono: uma task por porta consumindo uma fila MPSC de requisições.
+    // Com o motor ativo, as chamadas síncronas acima passam pela mesma fila e bloqueiam
+    // apenas a task chamadora até a conclusão.
+    esp_err_t start_async_worker(UBaseType_t priority, uint32_t stack_size);
+    esp_err_t submit_async(const AsyncRequest &request, TickType_t enqueue_timeout = 0);
+    bool is_async_worker_running() const { return worker_task_ != nullptr; }
+
+    // Circuit breaker: true enquanto as transações para o endereço falham rápido
+    bool is_device_isolated(uint8_t device_addr);
+
+    // Política usada pelo wrapper síncrono para cada dispositivo
+    esp_err_t set_device_priority(uint8_t device_addr, BusPriority priority, bool splittable = false);
+    esp_err_t set_device_max_speed(uint8_t device_addr, BusSpeed max_speed);
+    void set_max_chunk_bytes(size_t max_chunk_bytes) { max_chunk_bytes_ = (max_chunk_bytes > 0) ? max_chunk_bytes : 1; }
+    ArbitrationStats get_arbitration_stats() const { return arbitration_stats_; }
+    void reset_arbitration_stats() { arbitration_stats_ = {}; }
+
+    // Controle de clock por taxa de erro
+    void set_speed_policy(const SpeedPolicy &policy);
+    SpeedStats get_speed_stats() const { return speed_stats_; }
+    uint32_t get_clock_speed() const { return speed_stats_.clock_speed; }
+
+    // Snapshot/reset da telemetria por dispositivo
+    esp_err_t get_device_stats(uint8_t device_addr, DeviceStats *stats);
+    size_t snapshot_device_stats(DeviceStats *stats, size_t max_devices);
+    void reset_device_stats();
+    void log_device_stats();
     
     i2c_port_t get_port() const { return port_; }
     bool is_initialized() const { return initialized_; }
+    TransferCounters get_transfer_counters() const { return transfer_counters_; }
 
 private:
     i2c_port_t port_;
     bool initialized_;
-};
\ No newline at end of file
+
+    I2CBusBackend *backend_;
+    bool driver_installed_;
+    gpio_num_t sda_pin_;
+    gpio_num_t scl_pin_;
+
+#if !CONFIG_IDF_TARGET_LINUX
+    // START + endereço + segmentos + repeated START + endereço + leitura (2 ops) + STOP
+    static constexpr size_t MAX_LINK_OPERATIONS = MAX_WRITE_SEGMENTS + 7;
+
+    // Buffer do command link por barramento; protegido por bus_mutex_
+    uint8_t cmd_link_buffer_[I2C_LINK_RECOMMENDED_SIZE(MAX_LINK_OPERATIONS)];
+#endif
+    StaticSemaphore_t bus_mutex_storage_;
+    SemaphoreHandle_t bus_mutex_;
+    TransferCounters transfer_counters_;
+
+    static constexpr size_t ASYNC_QUEUE_LENGTH = 8;
+    static constexpr size_t MAX_TRACKED_DEVICES = 8;
+    static constexpr size_t DEFAULT_MAX_CHUNK_BYTES = 32;
+    static constexpr SpeedPolicy DEFAULT_SPEED_POLICY = {64, 4, 30000};
+
+    // Circuit breaker por dispositivo: abre após falhas consecutivas e a task de
+    // trabalho testa o dispositivo com backoff exponencial até ele responder. O limite
+    // fica acima do error_threshold padrão para que um clock alto demais derrube o
+    // clock antes de isolar o dispositivo.
+    static constexpr uint32_t BREAKER_FAILURE_THRESHOLD = 5;
+    static constexpr uint32_t BREAKER_INITIAL_BACKOFF_MS = 100;
+    static constexpr uint32_t BREAKER_MAX_BACKOFF_MS = 2000;
+    static constexpr uint32_t BREAKER_PROBE_TIMEOUT_MS = 5;
+
+    // Bus clear: pulsos de SCL até o escravo liberar SDA, meio período em µs
+    static constexpr int BUS_CLEAR_PULSES = 9;
+    static constexpr uint32_t BUS_CLEAR_HALF_PERIOD_US = 5;
+
+    enum class BreakerState : uint8_t {
+        CLOSED,
+        OPEN,
+        HALF_OPEN,
+    };
+
+    // Registro por dispositivo conhecido pelo barramento
+    struct DeviceEntry {
+        bool in_use;
+        uint8_t device_addr;
+        BusPriority priority;
+        bool splittable;
+        uint32_t max_speed;
+        BreakerState breaker_state;
+        uint32_t consecutive_failures;
+        uint32_t breaker_backoff_ms;
+        int64_t next_probe_us;
+        DeviceStats stats;
+    };
+
+    // Requisição em andamento numa classe de prioridade, com cursor do próximo pedaço
+    struct ActiveRequest {
+        bool active;
+        bool started;
+        AsyncRequest request;
+        size_t segment_index;
+        size_t segment_offset;
+    };
+
+    // Uma fila por classe de prioridade
+    uint8_t request_queue_storage_[PRIORITY_CLASS_COUNT][ASYNC_QUEUE_LENGTH * sizeof(AsyncRequest)];
+    StaticQueue_t request_queue_struct_[PRIORITY_CLASS_COUNT];
+    QueueHandle_t request_queues_[PRIORITY_CLASS_COUNT];
+    ActiveRequest active_requests_[PRIORITY_CLASS_COUNT];
+    TaskHandle_t worker_task_;
+
+    DeviceEntry devices_[MAX_TRACKED_DEVICES];
+    size_t max_chunk_bytes_;
+    ArbitrationStats arbitration_stats_;
+
+    uint32_t bus_max_speed_;
+    SpeedPolicy speed_policy_;
+    SpeedStats speed_stats_;
+    uint32_t window_transactions_;
+    uint32_t window_errors_;
+    int64_t last_speed_event_us_;
+    uint32_t open_breakers_;
+
+    static void async_worker_task(void *arg);
+    bool run_next_chunk();
+    void complete_active_request(ActiveRequest &active, esp_err_t result);
+    DeviceEntry *find_device(uint8_t device_addr, bool create);
+    void record_transaction(uint8_t device_addr, size_t bytes_written, size_t bytes_read, esp_err_t result,
+                            uint32_t latency_us, bool bus_was_busy, DeviceAccounting accounting);
+    static void sync_completion_callback(esp_err_t result, void *context);
+    uint32_t compute_target_speed() const;
+    void update_speed_control(esp_err_t result);
+    esp_err_t configure_clock(uint32_t clk_speed);
+    esp_err_t check_breaker(uint8_t device_addr, bool allow_trial);
+    void update_breaker(DeviceEntry &device, esp_err_t result);
+    bool service_breakers();
+    uint32_t transaction_deadline_ms(size_t wire_bytes) const;
+    static TickType_t deadline_ticks(uint32_t timeout_ms);
+    esp_err_t recover_stuck_bus();
+
+#if !CONFIG_IDF_TARGET_LINUX
+    esp_err_t install_driver(uint32_t clk_speed);
+    esp_err_t build_command_link(i2c_cmd_handle_t cmd, uint8_t device_addr, const WriteSegment *segments,
+                                 size_t segment_count, uint8_t *read_data, size_t read_len);
+    esp_err_t perform_hardware_transfer(uint8_t device_addr, const WriteSegment *segments, size_t segment_count,
+                                        uint8_t *read_data, size_t read_len, uint32_t timeout_ms);
+#endif
+    esp_err_t execute_transfer(uint8_t device_addr, const WriteSegment *segments, size_t segment_count,
+                               uint8_t *read_data, size_t read_len, uint32_t timeout_ms = 0,
+                               DeviceAccounting accounting = DeviceAccounting::TRACKED);
+    esp_err_t perform_transfer(uint8_t device_addr, const WriteSegment *segments, size_t segment_count,
+                               uint8_t *read_data, size_t read_len, uint32_t timeout_ms,
+                               DeviceAccounting accounting = DeviceAccounting::TRACKED);
+};
@@ -1,21 +1,129 @@
 #include "i2c_manager.hpp"
+#include "i2c_bus_backend.hpp"
 #include "esp_log.h"
+#include "esp_timer.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "driver/gpio.h"
+#include "esp_rom_sys.h"
+#endif
+#include <stdio.h>
 
 static const char *TAG = "I2CManager";
 
-I2CManager::I2CManager(i2c_port_t port) : port_(port), initialized_(false) {}
+I2CManager::I2CManager(i2c_port_t port)
+    : port_(port), initialized_(false), backend_(nullptr), driver_installed_(false), sda_pin_(GPIO_NUM_NC), scl_pin_(GPIO_NUM_NC),
+      bus_mutex_(nullptr), transfer_counters_{}, request_queues_{}, active_requests_{}, worker_task_(nullptr),
+      devices_{}, max_chunk_bytes_(DEFAULT_MAX_CHUNK_BYTES), arbitration_stats_{}, bus_max_speed_(0),
+      speed_policy_(DEFAULT_SPEED_POLICY), speed_stats_{}, window_transactions_(0), window_errors_(0),
+      last_speed_event_us_(0), open_breakers_(0) {}
 
 I2CManager::~I2CManager() {
-    if (initialized_) {
+    if (worker_task_ != nullptr) {
+        vTaskDelete(worker_task_);
+    }
+#if !CONFIG_IDF_TARGET_LINUX
+    if (driver_installed_) {
         i2c_driver_delete(port_);
     }
+#endif
+}
+
+esp_err_t I2CManager::attach_backend(I2CBusBackend *backend) {
+    if (initialized_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    backend_ = backend;
+    return ESP_OK;
 }
 
 esp_err_t I2CManager::initialize(gpio_num_t sda, gpio_num_t scl, uint32_t clk_speed) {
+    if (clk_speed == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (bus_mutex_ == nullptr) {
+        bus_mutex_ = xSemaphoreCreateMutexStatic(&bus_mutex_storage_);
+    }
+
+    sda_pin_ = sda;
+    scl_pin_ = scl;
+    bus_max_speed_ = clk_speed;
+
+    esp_err_t ret = configure_clock(clk_speed);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    if (speed_stats_.clock_speed != clk_speed) {
+        // Reinicialização que caiu de volta no clock anterior
+        return ESP_FAIL;
+    }
+
+    speed_stats_.target_speed = clk_speed;
+    last_speed_event_us_ = esp_timer_get_time();
+    initialized_ = true;
+    ESP_LOGI(TAG, "I2C port %d initialized at %lu Hz%s", port_, (unsigned long)clk_speed,
+             (backend_ != nullptr) ? " (backend)" : "");
+    return ESP_OK;
+}
+
+// Aplica um novo clock. No driver legado isso exige reinstalar o driver da porta;
+// chamado com bus_mutex_ tomado (ou antes de initialized_). Se a reinstalação falhar
+// o driver volta ao clock anterior e retorna ESP_OK com speed_stats_.clock_speed
+// inalterado; o erro só sobe se nem o clock anterior puder ser restaurado
+esp_err_t I2CManager::configure_clock(uint32_t clk_speed) {
+    if (backend_ != nullptr) {
+        esp_err_t ret = backend_->configure(clk_speed);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "I2C backend config failed: %s", esp_err_to_name(ret));
+            return ret;
+        }
+
+        speed_stats_.clock_speed = clk_speed;
+        return ESP_OK;
+    }
+
+#if CONFIG_IDF_TARGET_LINUX
+    ESP_LOGE(TAG, "I2C port %d has no backend on the linux target", port_);
+    return ESP_ERR_NOT_SUPPORTED;
+#else
+    uint32_t previous_speed = speed_stats_.clock_speed;
+    if (driver_installed_) {
+        i2c_driver_delete(port_);
+        driver_installed_ = false;
+    }
+
+    esp_err_t ret = install_driver(clk_speed);
+    if (ret == ESP_OK) {
+        speed_stats_.clock_speed = clk_speed;
+        return ESP_OK;
+    }
+
+    if (previous_speed == 0 || previous_speed == clk_speed) {
+        initialized_ = false;
+        return ret;
+    }
+
+    esp_err_t restore = install_driver(previous_speed);
+    if (restore != ESP_OK) {
+        ESP_LOGE(TAG, "I2C%d could not restore %lu Hz: %s", (int)port_, (unsigned long)previous_speed,
+                 esp_err_to_name(restore));
+        initialized_ = false;
+        return ret;
+    }
+
+    ESP_LOGW(TAG, "I2C%d kept %lu Hz, %lu Hz rejected", (int)port_, (unsigned long)previous_speed,
+             (unsigned long)clk_speed);
+    return ESP_OK;
+#endif
+}
+
+#if !CONFIG_IDF_TARGET_LINUX
+esp_err_t I2CManager::install_driver(uint32_t clk_speed) {
     i2c_config_t conf = {
         .mode = I2C_MODE_MASTER,
-        .sda_io_num = sda,
-        .scl_io_num = scl,
+        .sda_io_num = sda_pin_,
+        .scl_io_num = scl_pin_,
         .sda_pullup_en = GPIO_PULLUP_ENABLE,
         .scl_pullup_en = GPIO_PULLUP_ENABLE,
         .master = {
@@ -36,65 +144,901 @@ esp_err_t I2CManager::initialize(gpio_num_t sda, gpio_num_t scl, uint32_t clk_sp
         return ret;
     }
 
-    initialized_ = true;
-    ESP_LOGI(TAG, "I2C port %d initialized", port_);
+    driver_installed_ = true;
     return ESP_OK;
 }
+#endif
 
 esp_err_t I2CManager::probe_device(uint8_t device_addr) {
-    if (!initialized_) {
-        return ESP_ERR_INVALID_STATE;
-    }
+    return probe_device(device_addr, 0);
+}
 
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_stop(cmd);
-    esp_err_t ret = i2c_master_cmd_begin(port_, cmd, 1000 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
+esp_err_t I2CManager::probe_device(uint8_t device_addr, uint32_t timeout_ms, bool log_found) {
+    esp_err_t ret = execute_transfer(device_addr, nullptr, 0, nullptr, 0, timeout_ms);
 
-    if (ret == ESP_OK) {
+    if (ret == ESP_OK && log_found) {
         ESP_LOGI(TAG, "I2C device found at address 0x%02X", device_addr);
     }
 
     return ret;
 }
 
+esp_err_t I2CManager::scan_probe(uint8_t device_addr, uint32_t timeout_ms) {
+    return execute_transfer(device_addr, nullptr, 0, nullptr, 0, timeout_ms, DeviceAccounting::SCAN);
+}
+
 esp_err_t I2CManager::write_register(uint8_t device_addr, uint8_t reg_addr, uint8_t data) {
+    return write_register_block(device_addr, reg_addr, &data, 1);
+}
+
+esp_err_t I2CManager::write_register_block(uint8_t device_addr, uint8_t reg_addr, const uint8_t *data, size_t len) {
+    const WriteSegment segments[] = {
+        {&reg_addr, 1},
+        {data, len},
+    };
+    return execute_transfer(device_addr, segments, (len > 0) ? 2 : 1, nullptr, 0);
+}
+
+esp_err_t I2CManager::write_bytes(uint8_t device_addr, const uint8_t *data, size_t len) {
+    if (data == nullptr || len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const WriteSegment segment = {data, len};
+    return execute_transfer(device_addr, &segment, 1, nullptr, 0);
+}
+
+esp_err_t I2CManager::write_segments(uint8_t device_addr, const WriteSegment *segments, size_t segment_count) {
+    if (segments == nullptr || segment_count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return execute_transfer(device_addr, segments, segment_count, nullptr, 0);
+}
+
+esp_err_t I2CManager::read_register(uint8_t device_addr, uint8_t reg_addr, uint8_t *data, size_t len) {
+    if (data == nullptr || len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const WriteSegment segment = {&reg_addr, 1};
+    return execute_transfer(device_addr, &segment, 1, data, len);
+}
+
+esp_err_t I2CManager::transfer(uint8_t device_addr, const WriteSegment *segments, size_t segment_count,
+                               uint8_t *read_data, size_t read_len) {
+    if ((segment_count > 0 && segments == nullptr) || (read_len > 0 && read_data == nullptr)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return execute_transfer(device_addr, segments, segment_count, read_data, read_len);
+}
+
+esp_err_t I2CManager::forward_transfer(uint8_t device_addr, const WriteSegment *segments, size_t segment_count,
+                                       uint8_t *read_data, size_t read_len) {
+    if ((segment_count > 0 && segments == nullptr) || (read_len > 0 && read_data == nullptr)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return execute_transfer(device_addr, segments, segment_count, read_data, read_len, 0,
+                            DeviceAccounting::UNTRACKED);
+}
+
+esp_err_t I2CManager::perform_transfer(uint8_t device_addr, const WriteSegment *segments, size_t segment_count,
+                                       uint8_t *read_data, size_t read_len, uint32_t timeout_ms,
+                                       DeviceAccounting accounting) {
+    bool bus_was_busy = false;
+    if (xSemaphoreTake(bus_mutex_, 0) != pdTRUE) {
+        bus_was_busy = true;
+        xSemaphoreTake(bus_mutex_, portMAX_DELAY);
+    }
+
+    size_t bytes_written = 0;
+    for (size_t i = 0; i < segment_count; i++) {
+        bytes_written += segments[i].length;
+    }
+    if (timeout_ms == 0) {
+        timeout_ms = transaction_deadline_ms(bytes_written + read_len + 2);
+    }
+
+    int64_t start_us = esp_timer_get_time();
+#if CONFIG_IDF_TARGET_LINUX
+    esp_err_t ret = backend_->transfer(device_addr, segments, segment_count, read_data, read_len);
+#else
+    esp_err_t ret = (backend_ != nullptr)
+                        ? backend_->transfer(device_addr, segments, segment_count, read_data, read_len)
+                        : perform_hardware_transfer(device_addr, segments, segment_count, read_data, read_len,
+                                                    timeout_ms);
+#endif
+    uint32_t latency_us = (uint32_t)(esp_timer_get_time() - start_us);
+    transfer_counters_.transactions++;
+
+    // Timeout com SDA presa em nível baixo: um escravo travou no meio de um byte
+    if (ret == ESP_ERR_TIMEOUT) {
+        recover_stuck_bus();
+    }
+
+    record_transaction(device_addr, bytes_written, read_len, ret, latency_us, bus_was_busy, accounting);
+
+    xSemaphoreGive(bus_mutex_);
+    return ret;
+}
+
+esp_err_t I2CManager::start_async_worker(UBaseType_t priority, uint32_t stack_size) {
+    if (!initialized_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (worker_task_ != nullptr) {
+        return ESP_OK;
+    }
+
+    for (size_t i = 0; i < PRIORITY_CLASS_COUNT; i++) {
+        request_queues_[i] = xQueueCreateStatic(ASYNC_QUEUE_LENGTH, sizeof(AsyncRequest),
+                                                request_queue_storage_[i], &request_queue_struct_[i]);
+        if (request_queues_[i] == nullptr) {
+            ESP_LOGE(TAG, "I2C port %d request queue creation failed", port_);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    char task_name[16];
+    snprintf(task_name, sizeof(task_name), "i2c%d_worker", (int)port_);
+
+    BaseType_t task_result = xTaskCreate(async_worker_task, task_name, stack_size, this, priority, &worker_task_);
+    if (task_result != pdPASS) {
+        ESP_LOGE(TAG, "I2C port %d worker task creation failed", port_);
+        worker_task_ = nullptr;
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "I2C port %d async worker started", port_);
+    return ESP_OK;
+}
+
+esp_err_t I2CManager::submit_async(const AsyncRequest &request, TickType_t enqueue_timeout) {
+    if (!initialized_ || worker_task_ == nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    size_t priority_class = static_cast<size_t>(request.priority);
+    if (request.segment_count > MAX_WRITE_SEGMENTS || priority_class >= PRIORITY_CLASS_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    AsyncRequest queued = request;
+    queued.enqueue_time_us = esp_timer_get_time();
+    if (xQueueSend(request_queues_[priority_class], &queued, enqueue_timeout) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    xTaskNotifyGive(worker_task_);
+    return ESP_OK;
+}
+
+esp_err_t I2CManager::set_device_priority(uint8_t device_addr, BusPriority priority, bool splittable) {
     if (!initialized_) {
         return ESP_ERR_INVALID_STATE;
     }
 
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, reg_addr, true);
-    i2c_master_write_byte(cmd, data, true);
-    i2c_master_stop(cmd);
-    esp_err_t ret = i2c_master_cmd_begin(port_, cmd, 1000 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
+    xSemaphoreTake(bus_mutex_, portMAX_DELAY);
+    DeviceEntry *device = find_device(device_addr, true);
+    if (device != nullptr) {
+        device->priority = priority;
+        device->splittable = splittable;
+    }
+    xSemaphoreGive(bus_mutex_);
+
+    return (device != nullptr) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t I2CManager::set_device_max_speed(uint8_t device_addr, BusSpeed max_speed) {
+    if (!initialized_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(bus_mutex_, portMAX_DELAY);
+    esp_err_t ret = ESP_ERR_NO_MEM;
+    DeviceEntry *device = find_device(device_addr, true);
+    if (device != nullptr) {
+        uint32_t previous_target = speed_stats_.target_speed;
+        device->max_speed = static_cast<uint32_t>(max_speed);
+        speed_stats_.target_speed = compute_target_speed();
+
+        // Fora de fallback o barramento acompanha o alvo; em fallback só pode descer
+        ret = ESP_OK;
+        if (speed_stats_.clock_speed > speed_stats_.target_speed ||
+            speed_stats_.clock_speed == previous_target) {
+            if (speed_stats_.clock_speed != speed_stats_.target_speed) {
+                ret = configure_clock(speed_stats_.target_speed);
+                ESP_LOGI(TAG, "I2C%d clock set to %lu Hz (0x%02X limit)", (int)port_,
+                         (unsigned long)speed_stats_.clock_speed, device_addr);
+            }
+        }
+    }
+    xSemaphoreGive(bus_mutex_);
 
     return ret;
 }
 
-esp_err_t I2CManager::read_register(uint8_t device_addr, uint8_t reg_addr, uint8_t *data, size_t len) {
+void I2CManager::set_speed_policy(const SpeedPolicy &policy) {
+    speed_policy_ = policy;
+    if (speed_policy_.window_transactions == 0) {
+        speed_policy_.window_transactions = 1;
+    }
+    if (speed_policy_.error_threshold == 0) {
+        speed_policy_.error_threshold = 1;
+    }
+    window_transactions_ = 0;
+    window_errors_ = 0;
+}
+
+// Menor entre o teto do barramento e os limites dos dispositivos registrados
+uint32_t I2CManager::compute_target_speed() const {
+    uint32_t target = bus_max_speed_;
+    for (size_t i = 0; i < MAX_TRACKED_DEVICES; i++) {
+        if (devices_[i].in_use && devices_[i].max_speed > 0 && devices_[i].max_speed < target) {
+            target = devices_[i].max_speed;
+        }
+    }
+    return target;
+}
+
+// Chamado com bus_mutex_ tomado, após cada transação com um dispositivo conhecido
+void I2CManager::update_speed_control(esp_err_t result) {
+    static constexpr uint32_t SPEED_LEVELS[] = {
+        static_cast<uint32_t>(BusSpeed::STANDARD),
+        static_cast<uint32_t>(BusSpeed::FAST),
+        static_cast<uint32_t>(BusSpeed::FAST_PLUS),
+    };
+
+    int64_t now_us = esp_timer_get_time();
+    uint32_t current = speed_stats_.clock_speed;
+    uint32_t next_speed = current;
+
+    window_transactions_++;
+    if (result == ESP_FAIL || result == ESP_ERR_TIMEOUT) {
+        window_errors_++;
+        last_speed_event_us_ = now_us;
+    }
+
+    if (window_errors_ >= speed_policy_.error_threshold) {
+        // Desce para o nível padrão imediatamente abaixo do clock atual
+        for (uint32_t level : SPEED_LEVELS) {
+            if (level < current) {
+                next_speed = level;
+            }
+        }
+    } else if (current < speed_stats_.target_speed &&
+               now_us - last_speed_event_us_ >= (int64_t)speed_policy_.quiet_period_ms * 1000) {
+        // Sobe um nível, sem passar do alvo
+        next_speed = speed_stats_.target_speed;
+        for (uint32_t level : SPEED_LEVELS) {
+            if (level > current && level < next_speed) {
+                next_speed = level;
+            }
+        }
+    }
+
+    if (window_errors_ >= speed_policy_.error_threshold ||
+        window_transactions_ >= speed_policy_.window_transactions) {
+        window_transactions_ = 0;
+        window_errors_ = 0;
+    }
+
+    if (next_speed == current) {
+        return;
+    }
+
+    last_speed_event_us_ = now_us;
+    window_transactions_ = 0;
+    window_errors_ = 0;
+
+    if (configure_clock(next_speed) != ESP_OK || speed_stats_.clock_speed != next_speed) {
+        return;
+    }
+
+    if (next_speed < current) {
+        speed_stats_.step_downs++;
+        ESP_LOGW(TAG, "I2C%d error rate high, clock %lu -> %lu Hz", (int)port_, (unsigned long)current,
+                 (unsigned long)next_speed);
+    } else {
+        speed_stats_.step_ups++;
+        ESP_LOGI(TAG, "I2C%d quiet, clock %lu -> %lu Hz", (int)port_, (unsigned long)current,
+                 (unsigned long)next_speed);
+    }
+}
+
+I2CManager::DeviceEntry *I2CManager::find_device(uint8_t device_addr, bool create) {
+    DeviceEntry *free_entry = nullptr;
+    for (size_t i = 0; i < MAX_TRACKED_DEVICES; i++) {
+        if (devices_[i].in_use && devices_[i].device_addr == device_addr) {
+            return &devices_[i];
+        }
+        if (!devices_[i].in_use && free_entry == nullptr) {
+            free_entry = &devices_[i];
+        }
+    }
+
+    if (!create || free_entry == nullptr) {
+        return nullptr;
+    }
+
+    *free_entry = {};
+    free_entry->in_use = true;
+    free_entry->device_addr = device_addr;
+    free_entry->priority = BusPriority::USER_FEEDBACK;
+    free_entry->splittable = false;
+    free_entry->stats.device_addr = device_addr;
+    return free_entry;
+}
+
+// Chamado com bus_mutex_ tomado, logo após cada transação física
+void I2CManager::record_transaction(uint8_t device_addr, size_t bytes_written, size_t bytes_read, esp_err_t result,
+                                    uint32_t latency_us, bool bus_was_busy, DeviceAccounting accounting) {
+    // Repasses não têm registro aqui, mas o clock é o do barramento físico
+    if (accounting == DeviceAccounting::UNTRACKED) {
+        update_speed_control(result);
+        return;
+    }
+
+    // Fora do scan a primeira falha também cria o registro: um dispositivo ausente
+    // desde o boot precisa de contadores e disjuntor para parar de gastar timeouts
+    DeviceEntry *device = find_device(device_addr, result == ESP_OK || accounting == DeviceAccounting::TRACKED);
+    if (device == nullptr) {
+        return;
+    }
+
+    DeviceStats &stats = device->stats;
+    stats.transactions++;
+    if (bus_was_busy) {
+        stats.bus_busy_retries++;
+    }
+
+    if (result == ESP_OK) {
+        stats.bytes_written += bytes_written;
+        stats.bytes_read += bytes_read;
+    } else if (result == ESP_ERR_TIMEOUT) {
+        stats.timeouts++;
+    } else if (result == ESP_FAIL) {
+        stats.nacks++;
+    }
+
+    size_t bucket = 0;
+    while (bucket < LATENCY_BUCKET_COUNT - 1 && latency_us > LATENCY_BUCKET_LIMITS_US[bucket]) {
+        bucket++;
+    }
+    stats.latency_histogram[bucket]++;
+    if (latency_us > stats.max_latency_us) {
+        stats.max_latency_us = latency_us;
+    }
+
+    // Falhas de um dispositivo já isolado não dizem nada sobre o clock do barramento
+    bool isolated = device->breaker_state != BreakerState::CLOSED;
+    update_breaker(*device, result);
+    if (!isolated) {
+        update_speed_control(result);
+    }
+}
+
+// Chamado com bus_mutex_ tomado
+void I2CManager::update_breaker(DeviceEntry &device, esp_err_t result) {
+    if (result == ESP_OK) {
+        if (device.breaker_state != BreakerState::CLOSED) {
+            ESP_LOGI(TAG, "I2C%d 0x%02X responding again, circuit closed", (int)port_, device.device_addr);
+            open_breakers_--;
+        }
+        device.breaker_state = BreakerState::CLOSED;
+        device.consecutive_failures = 0;
+        return;
+    }
+
+    // Fora do teste de recuperação só NACK e timeout contam contra o dispositivo. No
+    // teste qualquer erro reabre o circuito: em HALF_OPEN ninguém mais tentaria de novo.
+    if (device.breaker_state != BreakerState::HALF_OPEN && result != ESP_FAIL && result != ESP_ERR_TIMEOUT) {
+        return;
+    }
+
+    device.consecutive_failures++;
+    int64_t now_us = esp_timer_get_time();
+
+    if (device.breaker_state == BreakerState::CLOSED) {
+        if (device.consecutive_failures >= BREAKER_FAILURE_THRESHOLD) {
+            device.breaker_state = BreakerState::OPEN;
+            device.breaker_backoff_ms = BREAKER_INITIAL_BACKOFF_MS;
+            device.next_probe_us = now_us + (int64_t)device.breaker_backoff_ms * 1000;
+            device.stats.breaker_trips++;
+            open_breakers_++;
+            ESP_LOGW(TAG, "I2C%d 0x%02X failed %lu times in a row, circuit open", (int)port_, device.device_addr,
+                     (unsigned long)device.consecutive_failures);
+        }
+    } else {
+        // Teste de recuperação falhou: dobra o intervalo até o máximo
+        device.breaker_state = BreakerState::OPEN;
+        device.breaker_backoff_ms *= 2;
+        if (device.breaker_backoff_ms > BREAKER_MAX_BACKOFF_MS) {
+            device.breaker_backoff_ms = BREAKER_MAX_BACKOFF_MS;
+        }
+        device.next_probe_us = now_us + (int64_t)device.breaker_backoff_ms * 1000;
+    }
+}
+
+// ESP_ERR_NOT_ALLOWED enquanto o circuito do dispositivo estiver aberto. Sem task de
+// trabalho, a primeira chamada depois do backoff vira o teste de recuperação.
+esp_err_t I2CManager::check_breaker(uint8_t device_addr, bool allow_trial) {
+    esp_err_t ret = ESP_OK;
+
+    xSemaphoreTake(bus_mutex_, portMAX_DELAY);
+    DeviceEntry *device = find_device(device_addr, false);
+    if (device != nullptr && device->breaker_state != BreakerState::CLOSED) {
+        if (allow_trial && device->breaker_state == BreakerState::OPEN &&
+            esp_timer_get_time() >= device->next_probe_us) {
+            device->breaker_state = BreakerState::HALF_OPEN;
+        } else {
+            device->stats.fast_failures++;
+            ret = ESP_ERR_NOT_ALLOWED;
+        }
+    }
+    xSemaphoreGive(bus_mutex_);
+
+    return ret;
+}
+
+// Executado pela task de trabalho: testa com um probe curto os dispositivos isolados
+// cujo backoff venceu. Retorna true se ainda há circuitos abertos.
+bool I2CManager::service_breakers() {
+    if (open_breakers_ == 0) {
+        return false;
+    }
+
+    int64_t now_us = esp_timer_get_time();
+    for (size_t i = 0; i < MAX_TRACKED_DEVICES; i++) {
+        uint8_t device_addr = 0;
+
+        xSemaphoreTake(bus_mutex_, portMAX_DELAY);
+        DeviceEntry &device = devices_[i];
+        bool due = device.in_use && device.breaker_state == BreakerState::OPEN && now_us >= device.next_probe_us;
+        if (due) {
+            device.breaker_state = BreakerState::HALF_OPEN;
+            device_addr = device.device_addr;
+        }
+        xSemaphoreGive(bus_mutex_);
+
+        if (due) {
+            perform_transfer(device_addr, nullptr, 0, nullptr, 0, BREAKER_PROBE_TIMEOUT_MS);
+        }
+    }
+
+    return open_breakers_ > 0;
+}
+
+bool I2CManager::is_device_isolated(uint8_t device_addr) {
+    if (!initialized_) {
+        return false;
+    }
+
+    xSemaphoreTake(bus_mutex_, portMAX_DELAY);
+    const DeviceEntry *device = find_device(device_addr, false);
+    bool isolated = (device != nullptr) && device->breaker_state != BreakerState::CLOSED;
+    xSemaphoreGive(bus_mutex_);
+
+    return isolated;
+}
+
+// Tempo de fio esperado para wire_bytes no clock atual (9 bits por byte), com folga
+uint32_t I2CManager::transaction_deadline_ms(size_t wire_bytes) const {
+    uint32_t clock_speed = (speed_stats_.clock_speed > 0) ? speed_stats_.clock_speed : 100000;
+    uint64_t wire_time_us = (uint64_t)wire_bytes * 9 * 1000000 / clock_speed;
+    return (uint32_t)(wire_time_us * DEADLINE_SLACK_FACTOR / 1000) + DEADLINE_MARGIN_MS;
+}
+
+// Prazo em ticks arredondado para cima, +1 porque o timeout do driver conta a partir
+// de um ponto qualquer do tick atual. Com tick de 10 ms uma transação curta teria
+// 1 tick, que pode vencer quase na hora: nunca menos que MIN_DEADLINE_TICKS.
+TickType_t I2CManager::deadline_ticks(uint32_t timeout_ms) {
+    uint64_t ticks = ((uint64_t)timeout_ms * configTICK_RATE_HZ + 999) / 1000 + 1;
+    if (ticks < MIN_DEADLINE_TICKS) {
+        ticks = MIN_DEADLINE_TICKS;
+    }
+    return (ticks > portMAX_DELAY) ? portMAX_DELAY : (TickType_t)ticks;
+}
+
+// Chamado com bus_mutex_ tomado depois de um timeout. Se SDA estiver presa em nível
+// baixo, gera até 9 pulsos de SCL para o escravo terminar o byte, um STOP, e
+// reinstala o driver.
+esp_err_t I2CManager::recover_stuck_bus() {
+    if (backend_ != nullptr) {
+        if (!backend_->is_sda_stuck()) {
+            return ESP_OK;
+        }
+        transfer_counters_.bus_clears++;
+        ESP_LOGW(TAG, "I2C%d SDA stuck low, clearing bus", (int)port_);
+        return backend_->clear_bus();
+    }
+
+#if CONFIG_IDF_TARGET_LINUX
+    return ESP_ERR_NOT_SUPPORTED;
+#else
+    if (gpio_get_level(sda_pin_) != 0) {
+        return ESP_OK;
+    }
+
+    transfer_counters_.bus_clears++;
+    ESP_LOGW(TAG, "I2C%d SDA stuck low, clearing bus", (int)port_);
+
+    if (driver_installed_) {
+        i2c_driver_delete(port_);
+        driver_installed_ = false;
+    }
+
+    gpio_set_direction(scl_pin_, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_direction(sda_pin_, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_pull_mode(scl_pin_, GPIO_PULLUP_ONLY);
+    gpio_set_pull_mode(sda_pin_, GPIO_PULLUP_ONLY);
+    gpio_set_level(sda_pin_, 1);
+    gpio_set_level(scl_pin_, 1);
+
+    for (int i = 0; i < BUS_CLEAR_PULSES && gpio_get_level(sda_pin_) == 0; i++) {
+        gpio_set_level(scl_pin_, 0);
+        esp_rom_delay_us(BUS_CLEAR_HALF_PERIOD_US);
+        gpio_set_level(scl_pin_, 1);
+        esp_rom_delay_us(BUS_CLEAR_HALF_PERIOD_US);
+    }
+
+    // STOP: SDA sobe com SCL em nível alto
+    gpio_set_level(scl_pin_, 0);
+    esp_rom_delay_us(BUS_CLEAR_HALF_PERIOD_US);
+    gpio_set_level(sda_pin_, 0);
+    esp_rom_delay_us(BUS_CLEAR_HALF_PERIOD_US);
+    gpio_set_level(scl_pin_, 1);
+    esp_rom_delay_us(BUS_CLEAR_HALF_PERIOD_US);
+    gpio_set_level(sda_pin_, 1);
+    esp_rom_delay_us(BUS_CLEAR_HALF_PERIOD_US);
+
+    bool released = gpio_get_level(sda_pin_) != 0;
+    esp_err_t ret = configure_clock(speed_stats_.clock_speed);
+    if (!released) {
+        ESP_LOGE(TAG, "I2C%d SDA still low after bus clear", (int)port_);
+        return ESP_FAIL;
+    }
+
+    return ret;
+#endif
+}
+
+esp_err_t I2CManager::get_device_stats(uint8_t device_addr, DeviceStats *stats) {
+    if (!initialized_ || stats == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    xSemaphoreTake(bus_mutex_, portMAX_DELAY);
+    const DeviceEntry *device = find_device(device_addr, false);
+    if (device != nullptr) {
+        *stats = device->stats;
+    }
+    xSemaphoreGive(bus_mutex_);
+
+    return (device != nullptr) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+size_t I2CManager::snapshot_device_stats(DeviceStats *stats, size_t max_devices) {
+    if (!initialized_ || stats == nullptr) {
+        return 0;
+    }
+
+    size_t count = 0;
+    xSemaphoreTake(bus_mutex_, portMAX_DELAY);
+    for (size_t i = 0; i < MAX_TRACKED_DEVICES && count < max_devices; i++) {
+        if (devices_[i].in_use) {
+            stats[count++] = devices_[i].stats;
+        }
+    }
+    xSemaphoreGive(bus_mutex_);
+
+    return count;
+}
+
+void I2CManager::reset_device_stats() {
+    if (!initialized_) {
+        return;
+    }
+
+    xSemaphoreTake(bus_mutex_, portMAX_DELAY);
+    for (size_t i = 0; i < MAX_TRACKED_DEVICES; i++) {
+        devices_[i].stats = {};
+        devices_[i].stats.device_addr = devices_[i].device_addr;
+    }
+    xSemaphoreGive(bus_mutex_);
+}
+
+void I2CManager::log_device_stats() {
+    DeviceStats stats[MAX_TRACKED_DEVICES];
+    size_t count = snapshot_device_stats(stats, MAX_TRACKED_DEVICES);
+
+    SpeedStats speed = speed_stats_;
+    ESP_LOGI(TAG, "I2C%d clock %lu Hz (target %lu Hz), %lu step-downs, %lu step-ups", (int)port_,
+             (unsigned long)speed.clock_speed, (unsigned long)speed.target_speed,
+             (unsigned long)speed.step_downs, (unsigned long)speed.step_ups);
+
+    for (size_t i = 0; i < count; i++) {
+        const DeviceStats &device = stats[i];
+        ESP_LOGI(TAG, "I2C%d 0x%02X: %lu tx, %lu B out, %lu B in, %lu NACK, %lu timeout, %lu busy, max %lu us",
+                 (int)port_, device.device_addr, (unsigned long)device.transactions,
+                 (unsigned long)device.bytes_written, (unsigned long)device.bytes_read,
+                 (unsigned long)device.nacks, (unsigned long)device.timeouts,
+                 (unsigned long)device.bus_busy_retries, (unsigned long)device.max_latency_us);
+        ESP_LOGI(TAG, "  circuit breaker: %lu trips, %lu fast failures",
+                 (unsigned long)device.breaker_trips, (unsigned long)device.fast_failures);
+        ESP_LOGI(TAG, "  latency <=100/200/500/1k/2k/5k/10k/>10k us: %lu/%lu/%lu/%lu/%lu/%lu/%lu/%lu",
+                 (unsigned long)device.latency_histogram[0], (unsigned long)device.latency_histogram[1],
+                 (unsigned long)device.latency_histogram[2], (unsigned long)device.latency_histogram[3],
+                 (unsigned long)device.latency_histogram[4], (unsigned long)device.latency_histogram[5],
+                 (unsigned long)device.latency_histogram[6], (unsigned long)device.latency_histogram[7]);
+    }
+}
+
+void I2CManager::async_worker_task(void *arg) {
+    I2CManager *manager = static_cast<I2CManager *>(arg);
+
+    while (true) {
+        // Executa pedaços enquanto houver trabalho; dorme até a próxima submissão, ou
+        // até o próximo teste de recuperação se houver dispositivo isolado
+        bool breakers_open = manager->service_breakers();
+        if (!manager->run_next_chunk()) {
+            ulTaskNotifyTake(pdTRUE, breakers_open ? pdMS_TO_TICKS(BREAKER_INITIAL_BACKOFF_MS) : portMAX_DELAY);
+        }
+    }
+}
+
+// Executa um único pedaço da requisição de maior prioridade pendente. Uma escrita
+// longa de menor prioridade é retomada do cursor depois, então uma leitura de sensor
+// espera no máximo um pedaço.
+bool I2CManager::run_next_chunk() {
+    ActiveRequest *active = nullptr;
+    for (size_t i = 0; i < PRIORITY_CLASS_COUNT && active == nullptr; i++) {
+        if (active_requests_[i].active) {
+            active = &active_requests_[i];
+        } else if (xQueueReceive(request_queues_[i], &active_requests_[i].request, 0) == pdTRUE) {
+            active = &active_requests_[i];
+            active->active = true;
+            active->started = false;
+            active->segment_index = 1;
+            active->segment_offset = 0;
+        }
+    }
+
+    if (active == nullptr) {
+        return false;
+    }
+
+    AsyncRequest &request = active->request;
+    size_t priority_class = static_cast<size_t>(request.priority);
+    int64_t chunk_start_us = esp_timer_get_time();
+
+    if (!active->started) {
+        // Requisições enfileiradas para um dispositivo isolado falham sem tocar no barramento
+        if (check_breaker(request.device_addr, false) != ESP_OK) {
+            complete_active_request(*active, ESP_ERR_NOT_ALLOWED);
+            return true;
+        }
+
+        active->started = true;
+        int64_t wait_us = chunk_start_us - request.enqueue_time_us;
+        arbitration_stats_.requests[priority_class]++;
+        if (wait_us > arbitration_stats_.max_wait_us[priority_class]) {
+            arbitration_stats_.max_wait_us[priority_class] = wait_us;
+        }
+    }
+
+    esp_err_t result;
+    bool finished = true;
+
+    if (!request.splittable || request.read_len > 0 || request.segment_count < 2) {
+        result = perform_transfer(request.device_addr, request.segments, request.segment_count,
+                                  request.read_data, request.read_len, request.timeout_ms, request.accounting);
+    } else {
+        // Pedaço = prefixo (segments[0]) + até max_chunk_bytes_ do payload a partir do cursor
+        WriteSegment chunk[MAX_WRITE_SEGMENTS];
+        size_t chunk_count = 0;
+        size_t budget = max_chunk_bytes_;
+        chunk[chunk_count++] = request.segments[0];
+
+        while (budget > 0 && active->segment_index < request.segment_count && chunk_count < MAX_WRITE_SEGMENTS) {
+            const WriteSegment &segment = request.segments[active->segment_index];
+            size_t take = segment.length - active->segment_offset;
+            if (take > budget) {
+                take = budget;
+            }
+            if (take > 0) {
+                chunk[chunk_count++] = {segment.data + active->segment_offset, take};
+            }
+            active->segment_offset += take;
+            budget -= take;
+            if (active->segment_offset >= segment.length) {
+                active->segment_index++;
+                active->segment_offset = 0;
+            }
+        }
+
+        result = perform_transfer(request.device_addr, chunk, chunk_count, nullptr, 0, request.timeout_ms,
+                                  request.accounting);
+        finished = (result != ESP_OK) || (active->segment_index >= request.segment_count);
+    }
+
+    int64_t chunk_duration_us = esp_timer_get_time() - chunk_start_us;
+    arbitration_stats_.chunks_executed++;
+    if (chunk_duration_us > arbitration_stats_.max_chunk_us) {
+        arbitration_stats_.max_chunk_us = chunk_duration_us;
+    }
+
+    if (finished) {
+        complete_active_request(*active, result);
+    }
+
+    return true;
+}
+
+void I2CManager::complete_active_request(ActiveRequest &active, esp_err_t result) {
+    // Libera o slot antes do callback, que pode submeter uma nova requisição
+    AsyncRequest request = active.request;
+    active.active = false;
+
+    if (request.on_complete != nullptr) {
+        request.on_complete(result, request.context);
+    }
+}
+
+// Contexto da chamada síncrona, vive na pilha da task que aguarda. O sinal é um
+// semáforo só desta chamada: notificações da task vindas de outro lugar (timers,
+// pedidos de parada) não encerram a espera antes da hora.
+struct SyncCompletion {
+    SemaphoreHandle_t done_signal;
+    volatile bool done;
+    esp_err_t result;
+};
+
+// O xSemaphoreGive é o último acesso ao contexto: depois dele a pilha pode sumir
+void I2CManager::sync_completion_callback(esp_err_t result, void *context) {
+    SyncCompletion *completion = static_cast<SyncCompletion *>(context);
+    completion->result = result;
+    completion->done = true;
+    xSemaphoreGive(completion->done_signal);
+}
+
+esp_err_t I2CManager::execute_transfer(uint8_t device_addr, const WriteSegment *segments, size_t segment_count,
+                                       uint8_t *read_data, size_t read_len, uint32_t timeout_ms,
+                                       DeviceAccounting accounting) {
     if (!initialized_) {
         return ESP_ERR_INVALID_STATE;
     }
 
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, reg_addr, true);
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_READ, true);
-    if (len > 1) {
-        i2c_master_read(cmd, data, len - 1, I2C_MASTER_ACK);
+    if (segment_count > MAX_WRITE_SEGMENTS) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    if (accounting != DeviceAccounting::UNTRACKED) {
+        esp_err_t breaker_result = check_breaker(device_addr, worker_task_ == nullptr);
+        if (breaker_result != ESP_OK) {
+            return breaker_result;
+        }
+    }
+
+    // Sem motor assíncrono (ou chamado de dentro de um callback): executa direto
+    if (worker_task_ == nullptr || xTaskGetCurrentTaskHandle() == worker_task_) {
+        return perform_transfer(device_addr, segments, segment_count, read_data, read_len, timeout_ms, accounting);
+    }
+
+    // Wrapper síncrono: enfileira e bloqueia apenas a task chamadora até a conclusão
+    StaticSemaphore_t done_signal_storage;
+    SyncCompletion completion = {xSemaphoreCreateBinaryStatic(&done_signal_storage), false, ESP_FAIL};
+    AsyncRequest request = {};
+    request.device_addr = device_addr;
+    for (size_t i = 0; i < segment_count; i++) {
+        request.segments[i] = segments[i];
+    }
+    request.segment_count = segment_count;
+    request.read_data = read_data;
+    request.read_len = read_len;
+    request.timeout_ms = timeout_ms;
+    request.accounting = accounting;
+    request.on_complete = sync_completion_callback;
+    request.context = &completion;
+    request.priority = BusPriority::USER_FEEDBACK;
+    request.splittable = false;
+
+    xSemaphoreTake(bus_mutex_, portMAX_DELAY);
+    const DeviceEntry *device = find_device(device_addr, false);
+    if (device != nullptr) {
+        request.priority = device->priority;
+        request.splittable = device->splittable;
+    }
+    xSemaphoreGive(bus_mutex_);
+
+    esp_err_t submit_result = submit_async(request, portMAX_DELAY);
+    if (submit_result != ESP_OK) {
+        vSemaphoreDelete(completion.done_signal);
+        return submit_result;
+    }
+
+    do {
+        xSemaphoreTake(completion.done_signal, portMAX_DELAY);
+    } while (!completion.done);
+    vSemaphoreDelete(completion.done_signal);
+    return completion.result;
+}
+
+#if !CONFIG_IDF_TARGET_LINUX
+// Monta uma única transação: START, escrita de todos os segmentos, e opcionalmente
+// repeated START + leitura, terminando com um único STOP
+esp_err_t I2CManager::build_command_link(i2c_cmd_handle_t cmd, uint8_t device_addr, const WriteSegment *segments,
+                                         size_t segment_count, uint8_t *read_data, size_t read_len) {
+    esp_err_t ret = i2c_master_start(cmd);
+    if (ret == ESP_OK && (segment_count > 0 || read_len == 0)) {
+        ret = i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_WRITE, true);
+        for (size_t i = 0; ret == ESP_OK && i < segment_count; i++) {
+            if (segments[i].length > 0) {
+                ret = i2c_master_write(cmd, segments[i].data, segments[i].length, true);
+            }
+        }
+    }
+
+    if (ret == ESP_OK && read_len > 0) {
+        if (segment_count > 0) {
+            ret = i2c_master_start(cmd);
+        }
+        if (ret == ESP_OK) {
+            ret = i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_READ, true);
+        }
+        if (ret == ESP_OK && read_len > 1) {
+            ret = i2c_master_read(cmd, read_data, read_len - 1, I2C_MASTER_ACK);
+        }
+        if (ret == ESP_OK) {
+            ret = i2c_master_read_byte(cmd, read_data + read_len - 1, I2C_MASTER_NACK);
+        }
+    }
+
+    if (ret == ESP_OK) {
+        ret = i2c_master_stop(cmd);
+    }
+
+    return ret;
+}
+
+esp_err_t I2CManager::perform_hardware_transfer(uint8_t device_addr, const WriteSegment *segments,
+                                                size_t segment_count, uint8_t *read_data, size_t read_len,
+                                                uint32_t timeout_ms) {
+    // Caminho normal: command link construído no buffer estático do barramento
+    bool heap_link = false;
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(cmd_link_buffer_, sizeof(cmd_link_buffer_));
+    esp_err_t ret = (cmd != nullptr) ? build_command_link(cmd, device_addr, segments, segment_count, read_data, read_len)
+                                     : ESP_ERR_NO_MEM;
+
+    if (ret == ESP_ERR_NO_MEM) {
+        // Não deveria acontecer com MAX_WRITE_SEGMENTS respeitado; fica registrado nos contadores
+        if (cmd != nullptr) {
+            i2c_cmd_link_delete_static(cmd);
+        }
+        transfer_counters_.static_buffer_overflows++;
+        transfer_counters_.heap_allocations++;
+        heap_link = true;
+
+        cmd = i2c_cmd_link_create();
+        ret = (cmd != nullptr) ? build_command_link(cmd, device_addr, segments, segment_count, read_data, read_len)
+                               : ESP_ERR_NO_MEM;
+    }
+
+    if (ret == ESP_OK) {
+        ret = i2c_master_cmd_begin(port_, cmd, deadline_ticks(timeout_ms));
+    }
+
+    if (cmd != nullptr) {
+        if (heap_link) {
+            i2c_cmd_link_delete(cmd);
+        } else {
+            i2c_cmd_link_delete_static(cmd);
+        }
     }
-    i2c_master_read_byte(cmd, data + len - 1, I2C_MASTER_NACK);
-    i2c_master_stop(cmd);
-    esp_err_t ret = i2c_master_cmd_begin(port_, cmd, 1000 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
 
     return ret;
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "i2c_manager.hpp"
+#include "i2c_bus_backend.hpp"
+
+// Multiplexadores TCA9548A (um ou mais chips em cascata no mesmo barramento pai).
+// Cada chip tem 8 canais; o canal global é chip * 8 + canal. Só um canal fica
+// ativo por vez em todo o grupo, então sensores com o mesmo endereço podem ficar
+// em canais diferentes. A seleção é mantida em cache: transações seguidas no mesmo
+// canal não reescrevem o registrador de controle. Com um canal ligado os dispositivos
+// dele respondem no barramento pai, então nenhum endereço dos canais pode existir
+// também direto no pai. As transações dos canais passam pelo pai sem registro por
+// endereço (forward_transfer): saúde e disjuntor ficam em cada barramento virtual.
+class I2CMux {
+public:
+    static constexpr size_t CHANNELS_PER_MUX = 8;
+    static constexpr size_t MAX_MUXES = 8;
+    static constexpr uint8_t DEFAULT_ADDRESS = 0x70;
+
+    struct Stats {
+        uint32_t transfers;
+        uint32_t channel_switches;
+        uint32_t control_writes;
+        uint32_t select_errors;
+    };
+
+    I2CMux(I2CManager* parent_bus, const uint8_t* mux_addresses, size_t mux_count);
+
+    // Desliga todos os canais de todos os chips (estado conhecido após o reset)
+    esp_err_t initialize();
+    esp_err_t transfer(uint8_t channel, uint8_t device_addr, const I2CManager::WriteSegment* segments,
+                       size_t segment_count, uint8_t* read_data, size_t read_len);
+    esp_err_t disable_all();
+
+    size_t get_channel_count() const { return mux_count_ * CHANNELS_PER_MUX; }
+    I2CManager* get_parent_bus() const { return parent_bus_; }
+    Stats get_stats() const { return stats_; }
+    void reset_stats() { stats_ = {}; }
+
+private:
+    static constexpr uint8_t NO_CHANNEL = 0xFF;
+
+    I2CManager* parent_bus_;
+    uint8_t mux_addresses_[MAX_MUXES];
+    size_t mux_count_;
+    // Canal global ativo, ou NO_CHANNEL
+    uint8_t selected_channel_;
+    StaticSemaphore_t mutex_storage_;
+    SemaphoreHandle_t mutex_;
+    Stats stats_;
+
+    esp_err_t select_channel(uint8_t channel);
+};
+
+// Barramento virtual: um canal do multiplexador visto como I2CBusBackend, para
+// anexar a um I2CManager próprio e usar os drivers existentes sem mudança.
+// O clock é o do barramento pai; configure() só aceita o valor.
+class I2CMuxChannel : public I2CBusBackend {
+public:
+    I2CMuxChannel(I2CMux* mux, uint8_t channel);
+
+    esp_err_t configure(uint32_t clk_speed) override;
+    esp_err_t transfer(uint8_t device_addr, const I2CManager::WriteSegment* segments, size_t segment_count,
+                       uint8_t* read_data, size_t read_len) override;
+
+    uint8_t get_channel() const { return channel_; }
+
+private:
+    I2CMux* mux_;
+    uint8_t channel_;
+};
@@ -0,0 +1,116 @@
+#include "i2c_mux.hpp"
+#include "esp_log.h"
+
+static const char *TAG = "I2CMux";
+
+I2CMux::I2CMux(I2CManager* parent_bus, const uint8_t* mux_addresses, size_t mux_count)
+    : parent_bus_(parent_bus), mux_addresses_{}, mux_count_(0), selected_channel_(NO_CHANNEL),
+      mutex_(nullptr), stats_{} {
+    mux_count_ = (mux_count > MAX_MUXES) ? MAX_MUXES : mux_count;
+    for (size_t i = 0; i < mux_count_; i++) {
+        mux_addresses_[i] = mux_addresses[i];
+    }
+}
+
+esp_err_t I2CMux::initialize() {
+    if (mux_count_ == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (mutex_ == nullptr) {
+        mutex_ = xSemaphoreCreateMutexStatic(&mutex_storage_);
+    }
+
+    esp_err_t result = disable_all();
+    if (result != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao inicializar multiplexadores: %s", esp_err_to_name(result));
+        return result;
+    }
+
+    ESP_LOGI(TAG, "%u multiplexador(es), %u canais", (unsigned)mux_count_, (unsigned)get_channel_count());
+    return ESP_OK;
+}
+
+esp_err_t I2CMux::disable_all() {
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+
+    const uint8_t no_channels = 0;
+    esp_err_t result = ESP_OK;
+    for (size_t i = 0; i < mux_count_; i++) {
+        esp_err_t write_result = parent_bus_->write_bytes(mux_addresses_[i], &no_channels, 1);
+        stats_.control_writes++;
+        if (write_result != ESP_OK) {
+            result = write_result;
+        }
+    }
+    // Com falha o estado real é desconhecido: NO_CHANNEL força a reescrita na próxima seleção
+    selected_channel_ = NO_CHANNEL;
+
+    xSemaphoreGive(mutex_);
+    return result;
+}
+
+esp_err_t I2CMux::transfer(uint8_t channel, uint8_t device_addr, const I2CManager::WriteSegment* segments,
+                           size_t segment_count, uint8_t* read_data, size_t read_len) {
+    if (channel >= get_channel_count()) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (mutex_ == nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Seleção e transação formam uma unidade: outro canal não pode entrar no meio
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    esp_err_t result = select_channel(channel);
+    if (result == ESP_OK) {
+        result = parent_bus_->forward_transfer(device_addr, segments, segment_count, read_data, read_len);
+        stats_.transfers++;
+    }
+    xSemaphoreGive(mutex_);
+    return result;
+}
+
+// Chamado com mutex_ tomado. Trocar de chip desliga antes o canal do chip anterior,
+// senão os dois canais ficariam ligados ao mesmo tempo.
+esp_err_t I2CMux::select_channel(uint8_t channel) {
+    if (channel == selected_channel_) {
+        return ESP_OK;
+    }
+
+    size_t mux_index = channel / CHANNELS_PER_MUX;
+    if (selected_channel_ != NO_CHANNEL && selected_channel_ / CHANNELS_PER_MUX != mux_index) {
+        const uint8_t no_channels = 0;
+        esp_err_t result = parent_bus_->write_bytes(mux_addresses_[selected_channel_ / CHANNELS_PER_MUX],
+                                                    &no_channels, 1);
+        stats_.control_writes++;
+        if (result != ESP_OK) {
+            stats_.select_errors++;
+            selected_channel_ = NO_CHANNEL;
+            return result;
+        }
+    }
+
+    const uint8_t channel_mask = (uint8_t)(1u << (channel % CHANNELS_PER_MUX));
+    esp_err_t result = parent_bus_->write_bytes(mux_addresses_[mux_index], &channel_mask, 1);
+    stats_.control_writes++;
+    if (result != ESP_OK) {
+        stats_.select_errors++;
+        selected_channel_ = NO_CHANNEL;
+        return result;
+    }
+
+    selected_channel_ = channel;
+    stats_.channel_switches++;
+    return ESP_OK;
+}
+
+I2CMuxChannel::I2CMuxChannel(I2CMux* mux, uint8_t channel) : mux_(mux), channel_(channel) {}
+
+esp_err_t I2CMuxChannel::configure(uint32_t clk_speed) {
+    return (clk_speed > 0) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t I2CMuxChannel::transfer(uint8_t device_addr, const I2CManager::WriteSegment* segments,
+                                  size_t segment_count, uint8_t* read_data, size_t read_len) {
+    return mux_->transfer(channel_, device_addr, segments, segment_count, read_data, read_len);
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "smp3011_driver.hpp"
+
+// Varredura de vários SMP3011 (um por pneu, cada um no seu barramento virtual).
+// Um ciclo dispara a conversão de todos os sensores em rodízio e recolhe cada
+// resultado quando fica pronto, também em rodízio: as conversões correm em
+// paralelo e o ciclo cresce com o tempo de barramento por sensor, não com o
+// tempo de conversão.
+class MultiTireScheduler {
+public:
+    static constexpr size_t MAX_TIRES = 24;
+
+    struct TireReading {
+        float pressure_kilopascal;
+        uint32_t raw_pressure;
+        int64_t timestamp_us;
+        esp_err_t result;
+    };
+
+    struct Stats {
+        uint32_t cycles;
+        uint32_t last_cycle_us;
+        uint32_t max_cycle_us;
+        uint32_t conversions;
+        uint32_t errors;
+    };
+
+    MultiTireScheduler();
+
+    esp_err_t add_sensor(SMP3011Driver* sensor);
+    size_t get_sensor_count() const { return sensor_count_; }
+
+    // Ciclo não bloqueante: start_cycle() e depois service() até cycle_complete
+    esp_err_t start_cycle();
+    esp_err_t service(bool* cycle_complete);
+    bool is_cycle_active() const { return cycle_active_; }
+    // Tempo até o próximo sensor pendente ficar pronto
+    uint32_t get_ready_time_hint_us() const;
+
+    // Ciclo completo bloqueante
+    esp_err_t run_cycle();
+
+    const TireReading& get_reading(size_t index) const { return readings_[index]; }
+    Stats get_stats() const { return stats_; }
+    void reset_stats() { stats_ = {}; }
+
+private:
+    enum class SlotState : uint8_t {
+        IDLE,
+        TRIGGER_PENDING,
+        CONVERTING,
+        DONE,
+    };
+
+    SMP3011Driver* sensors_[MAX_TIRES];
+    SlotState states_[MAX_TIRES];
+    int64_t ready_us_[MAX_TIRES];
+    TireReading readings_[MAX_TIRES];
+    size_t sensor_count_;
+    size_t cursor_;
+    size_t remaining_;
+    bool cycle_active_;
+    int64_t cycle_start_us_;
+    Stats stats_;
+
+    void service_slot(size_t index);
+    void finish_slot(size_t index, esp_err_t result);
+};
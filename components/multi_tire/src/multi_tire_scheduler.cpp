@@ -0,0 +1,149 @@
+#include "multi_tire_scheduler.hpp"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "MultiTireScheduler";
+
+MultiTireScheduler::MultiTireScheduler()
+    : sensors_{}, states_{}, ready_us_{}, readings_{}, sensor_count_(0), cursor_(0), remaining_(0),
+      cycle_active_(false), cycle_start_us_(0), stats_{} {}
+
+esp_err_t MultiTireScheduler::add_sensor(SMP3011Driver* sensor) {
+    if (sensor == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (cycle_active_ || sensor_count_ >= MAX_TIRES) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    sensors_[sensor_count_] = sensor;
+    states_[sensor_count_] = SlotState::IDLE;
+    readings_[sensor_count_] = {};
+    readings_[sensor_count_].result = ESP_ERR_NOT_FOUND;
+    sensor_count_++;
+    return ESP_OK;
+}
+
+esp_err_t MultiTireScheduler::start_cycle() {
+    if (cycle_active_ || sensor_count_ == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (size_t i = 0; i < sensor_count_; i++) {
+        states_[i] = SlotState::TRIGGER_PENDING;
+    }
+    remaining_ = sensor_count_;
+    cycle_active_ = true;
+    cycle_start_us_ = esp_timer_get_time();
+    return ESP_OK;
+}
+
+// Uma passada em rodízio: cada sensor recebe no máximo uma operação (disparo ou
+// busca do resultado). O início da passada gira para nenhum canal ficar sempre por último.
+esp_err_t MultiTireScheduler::service(bool* cycle_complete) {
+    *cycle_complete = false;
+    if (!cycle_active_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (size_t step = 0; step < sensor_count_; step++) {
+        service_slot((cursor_ + step) % sensor_count_);
+    }
+    cursor_ = (cursor_ + 1) % sensor_count_;
+
+    if (remaining_ == 0) {
+        uint32_t cycle_us = (uint32_t)(esp_timer_get_time() - cycle_start_us_);
+        stats_.cycles++;
+        stats_.last_cycle_us = cycle_us;
+        stats_.max_cycle_us = (cycle_us > stats_.max_cycle_us) ? cycle_us : stats_.max_cycle_us;
+        cycle_active_ = false;
+        *cycle_complete = true;
+    }
+    return ESP_OK;
+}
+
+void MultiTireScheduler::service_slot(size_t index) {
+    SMP3011Driver* sensor = sensors_[index];
+
+    if (states_[index] == SlotState::TRIGGER_PENDING) {
+        esp_err_t result = sensor->start_measurement();
+        if (result != ESP_OK) {
+            finish_slot(index, result);
+            return;
+        }
+        states_[index] = SlotState::CONVERTING;
+        ready_us_[index] = esp_timer_get_time() + sensor->get_conversion_time_us();
+        return;
+    }
+
+    // Antes do tempo de conversão não há tráfego no barramento
+    if (states_[index] != SlotState::CONVERTING || esp_timer_get_time() < ready_us_[index]) {
+        return;
+    }
+
+    SMP3011Driver::Sample sample;
+    esp_err_t result = sensor->fetch_sample(&sample);
+    if (result == ESP_ERR_NOT_FINISHED) {
+        return;
+    }
+
+    if (result == ESP_OK) {
+        readings_[index].pressure_kilopascal = sample.pressure_kilopascal;
+        readings_[index].raw_pressure = sample.raw_pressure;
+        readings_[index].timestamp_us = sample.timestamp_us;
+    }
+    finish_slot(index, result);
+}
+
+void MultiTireScheduler::finish_slot(size_t index, esp_err_t result) {
+    states_[index] = SlotState::DONE;
+    readings_[index].result = result;
+    remaining_--;
+
+    if (result == ESP_OK) {
+        stats_.conversions++;
+    } else {
+        stats_.errors++;
+        ESP_LOGW(TAG, "Pneu %u: %s", (unsigned)index, esp_err_to_name(result));
+    }
+}
+
+uint32_t MultiTireScheduler::get_ready_time_hint_us() const {
+    if (!cycle_active_) {
+        return 0;
+    }
+
+    int64_t now_us = esp_timer_get_time();
+    int64_t earliest_us = INT64_MAX;
+    for (size_t i = 0; i < sensor_count_; i++) {
+        if (states_[i] == SlotState::TRIGGER_PENDING) {
+            return 0;
+        }
+        if (states_[i] == SlotState::CONVERTING && ready_us_[i] < earliest_us) {
+            earliest_us = ready_us_[i];
+        }
+    }
+
+    if (earliest_us == INT64_MAX || earliest_us <= now_us) {
+        return 0;
+    }
+    return (uint32_t)(earliest_us - now_us);
+}
+
+esp_err_t MultiTireScheduler::run_cycle() {
+    esp_err_t result = start_cycle();
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    // Dorme até o próximo sensor ficar pronto; sensor ainda ocupado depois do
+    // tempo previsto é sondado a cada tick (o driver limita a espera)
+    bool complete = false;
+    while ((result = service(&complete)) == ESP_OK && !complete) {
+        TickType_t wait_ticks = pdMS_TO_TICKS((get_ready_time_hint_us() + 999) / 1000);
+        vTaskDelay((wait_ticks > 0) ? wait_ticks : 1);
+    }
+    return result;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Fonte monoespaçada já no formato da GDDRAM: para cada glifo, cada página é uma
+// sequência de `width` bytes (um por coluna, bit 0 = linha de cima da página).
+// Numa linha alinhada a página o glifo vai para o framebuffer com um memcpy por página.
+struct DisplayFont {
+    // glyph_data[((glifo * pages) + página) * width + coluna]
+    const uint8_t* glyph_data;
+    uint8_t width;
+    uint8_t height;
+    uint8_t pages;
+    // Colunas em branco entre glifos
+    uint8_t spacing;
+    char first_char;
+    char last_char;
+    // Caractere fora da tabela; '\0' = célula em branco
+    char fallback_char;
+    // Fonte só de maiúsculas: 'a'..'z' usa os glifos de 'A'..'Z'
+    bool fold_lowercase;
+
+    // nullptr = célula em branco
+    const uint8_t* glyph(char c) const {
+        if (fold_lowercase && c >= 'a' && c <= 'z') {
+            c = (char)(c - 'a' + 'A');
+        }
+        if (c < first_char || c > last_char) {
+            if (fallback_char == '\0' || c == ' ') {
+                return nullptr;
+            }
+            c = fallback_char;
+        }
+        return glyph_data + (size_t)(c - first_char) * pages * width;
+    }
+
+    uint8_t advance() const { return width + spacing; }
+
+    uint16_t measure(const char* text) const {
+        size_t length = 0;
+        while (text[length] != '\0') {
+            length++;
+        }
+        return (length == 0) ? 0 : (uint16_t)(length * advance() - spacing);
+    }
+
+    // Fonte de interface 5x7 (ASCII 0x20..0x5F, minúsculas viram maiúsculas)
+    static const DisplayFont SMALL;
+    // Dígitos de 10x16 em sete segmentos para o valor da pressão ('-', '.', '0'..'9')
+    static const DisplayFont LARGE_NUMERIC;
+};
+
+// Tabela empacotada gerada em tempo de compilação. pixel(glifo, x, y) descreve a
+// fonte de forma legível (linhas de bits, segmentos); pack_font() transpõe para
+// colunas por página, sem custo em tempo de execução.
+template <uint8_t Width, uint8_t Height, size_t GlyphCount>
+struct PackedFont {
+    static constexpr uint8_t PAGES = (Height + 7) / 8;
+    uint8_t data[GlyphCount * PAGES * Width];
+};
+
+template <uint8_t Width, uint8_t Height, size_t GlyphCount, typename PixelSource>
+constexpr PackedFont<Width, Height, GlyphCount> pack_font(PixelSource pixel) {
+    PackedFont<Width, Height, GlyphCount> font = {};
+    constexpr uint8_t pages = PackedFont<Width, Height, GlyphCount>::PAGES;
+
+    for (size_t glyph = 0; glyph < GlyphCount; glyph++) {
+        for (uint8_t page = 0; page < pages; page++) {
+            for (uint8_t x = 0; x < Width; x++) {
+                uint8_t column = 0;
+                for (uint8_t bit = 0; bit < 8; bit++) {
+                    uint8_t y = (uint8_t)(page * 8 + bit);
+                    if (y < Height && pixel(glyph, x, y)) {
+                        column |= (uint8_t)(1u << bit);
+                    }
+                }
+                font.data[(glyph * pages + page) * Width + x] = column;
+            }
+        }
+    }
+    return font;
+}
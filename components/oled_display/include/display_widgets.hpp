@@ -0,0 +1,150 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "display_font.hpp"
+
+class OLEDDisplay;
+
+// Widgets retidos sobre o framebuffer do OLEDDisplay. Cada widget ocupa um
+// retângulo alinhado a páginas, guarda o que está na tela na resolução em que é
+// mostrado e só se marca para redesenho quando isso muda. WidgetScreen::render()
+// redesenha só os marcados; sem nenhum, não há o que entregar ao display.
+class Widget {
+public:
+    Widget(uint8_t x, uint8_t page, uint8_t width, uint8_t pages);
+    virtual ~Widget() {}
+
+    bool is_dirty() const { return dirty_; }
+    void invalidate() { dirty_ = true; }
+    // Apaga o retângulo do widget e redesenha
+    void render(OLEDDisplay& display);
+
+protected:
+    uint8_t x_;
+    uint8_t page_;
+    uint8_t width_;
+    uint8_t pages_;
+    bool dirty_;
+
+    virtual void draw(OLEDDisplay& display) = 0;
+};
+
+// Valor em degraus inteiros da resolução exibida. Sem histerese (padrão) o degrau
+// é sempre a leitura arredondada: a tela muda exatamente quando o valor formatado
+// muda. Com histerese só troca de degrau quando a entrada se afasta do exibido por
+// meio degrau mais hysteresis_steps, o que segura ruído em cima de uma fronteira
+// mas deixa a tela até hysteresis_steps + 0,5 degrau atrás da leitura.
+class QuantizedValue {
+public:
+    explicit QuantizedValue(float hysteresis_steps = 0.0f)
+        : hysteresis_steps_((hysteresis_steps > 0.0f) ? hysteresis_steps : 0.0f), steps_(0), valid_(false) {}
+
+    // true quando o degrau exibido mudou
+    bool update(float steps);
+    int32_t get_steps() const { return steps_; }
+    bool is_valid() const { return valid_; }
+    void reset() { valid_ = false; }
+
+private:
+    float hysteresis_steps_;
+    int32_t steps_;
+    bool valid_;
+};
+
+class LabelWidget : public Widget {
+public:
+    static constexpr size_t MAX_TEXT = 22;
+
+    LabelWidget(uint8_t x, uint8_t page, uint8_t width, const DisplayFont& font = DisplayFont::SMALL);
+
+    void set_text(const char* text);
+
+protected:
+    void draw(OLEDDisplay& display) override;
+
+private:
+    const DisplayFont* font_;
+    char text_[MAX_TEXT + 1];
+};
+
+// Número com casas decimais fixas e unidade. O valor é alinhado à direita antes da
+// unidade (os dígitos não dançam quando a largura muda); a unidade usa a fonte
+// pequena na última página do widget. hysteresis_steps em unidades da última casa.
+class NumericFieldWidget : public Widget {
+public:
+    static constexpr uint8_t MAX_PRECISION = 3;
+
+    NumericFieldWidget(uint8_t x, uint8_t page, uint8_t width, const DisplayFont& font, uint8_t precision,
+                       const char* unit, float hysteresis_steps = 0.0f);
+
+    void set_value(float value);
+    // Sem leitura: mostra "--" até o próximo set_value()
+    void set_unavailable();
+
+protected:
+    void draw(OLEDDisplay& display) override;
+
+private:
+    const DisplayFont* font_;
+    uint8_t precision_;
+    float scale_;
+    const char* unit_;
+    QuantizedValue value_;
+};
+
+// Barra horizontal de uma página com moldura; a resolução é um pixel de preenchimento
+// (hysteresis_steps em colunas)
+class BarGaugeWidget : public Widget {
+public:
+    BarGaugeWidget(uint8_t x, uint8_t page, uint8_t width, float min_value, float max_value,
+                   float hysteresis_steps = 0.0f);
+
+    void set_value(float value);
+
+protected:
+    void draw(OLEDDisplay& display) override;
+
+private:
+    float min_value_;
+    float max_value_;
+    QuantizedValue filled_columns_;
+};
+
+// Ícone 8x8 de estado
+class StatusIconWidget : public Widget {
+public:
+    enum class Icon : uint8_t {
+        NONE,
+        OK,
+        WARNING,
+        ERROR,
+    };
+
+    StatusIconWidget(uint8_t x, uint8_t page);
+
+    void set_icon(Icon icon);
+
+protected:
+    void draw(OLEDDisplay& display) override;
+
+private:
+    Icon icon_;
+};
+
+class WidgetScreen {
+public:
+    static constexpr size_t MAX_WIDGETS = 12;
+
+    WidgetScreen();
+
+    esp_err_t add(Widget* widget);
+    // Força o redesenho de todos (entrada na tela)
+    void invalidate_all();
+    // Redesenha os widgets marcados; retorna quantos
+    size_t render(OLEDDisplay& display);
+
+private:
+    Widget* widgets_[MAX_WIDGETS];
+    size_t widget_count_;
+};
@@ -1,9 +1,40 @@
 #pragma once
 #include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 #include "i2c_manager.hpp"
+#include "display_font.hpp"
+#include "display_widgets.hpp"
 
+// Todo desenho vai para um framebuffer de 1 KB em RAM (8 páginas x 128 colunas, um
+// byte = 8 pixels verticais, o mesmo formato da GDDRAM). Cada página guarda a faixa
+// de colunas que mudou desde o último present().
+// Buffer duplo: present() copia só as faixas alteradas do buffer de desenho para o
+// buffer da frente, que pertence ao envio. Com a task de flush rodando, present()
+// só faz essa cópia e acorda a task; o tempo de I2C fica fora de quem desenha.
+// Quadros entregues antes da task terminar o envio anterior se fundem (vale o
+// mais recente). O envio recorta cada faixa contra uma cópia do que já está no
+// painel: apagar e redesenhar o mesmo conteúdo não gera tráfego. Só as janelas que
+// restam vão para o painel, com 0x21/0x22.
+// Na tela de tendência o gráfico é varrido: cada coluna nova entra num cursor que
+// anda da esquerda para a direita e volta à coluna 0, com uma coluna apagada à
+// frente separando o novo do antigo. Nada se desloca, então cada amostra muda só
+// duas colunas do gráfico e o recorte do envio manda só essas (12 bytes de pixel).
+// O gráfico inteiro só é redesenhado quando a escala muda.
 class OLEDDisplay {
 public:
+    struct FlushStats {
+        uint32_t flushes;
+        uint32_t empty_flushes;
+        uint32_t windows;
+        uint32_t data_bytes;
+        uint32_t presents;
+        // Quadros substituídos por um mais novo antes de chegar ao painel
+        uint32_t merged_frames;
+        uint32_t send_errors;
+    };
+
     OLEDDisplay(I2CManager* i2c_manager, uint8_t device_address);
     ~OLEDDisplay();
 
@@ -11,18 +42,156 @@ public:
     void clear_display();
     void display_welcome_screen();
     void display_system_status(const char* status_message);
-    void display_sensor_readings(float temperature_celsius, float atmospheric_pressure_hpa, float tire_pressure_kpa);
+    // Tela de leituras em widgets retidos: cada valor só é redesenhado quando muda na
+    // resolução exibida, e sem mudança nada é entregue ao painel
+    void display_sensor_readings(float temperature_celsius, float atmospheric_pressure_hpa, float tire_pressure_kpa,
+                                 StatusIconWidget::Icon status = StatusIconWidget::Icon::OK);
     void display_error_message(const char* error_message);
+    // Tendência da pressão do pneu: uma coluna por período de coluna, com o mínimo e o
+    // máximo das amostras recebidas nele; amostras no meio do período só acumulam
+    void display_trend(float tire_pressure_kpa);
+    // Período de cada coluna do gráfico (mínimo de 1 ms); vale a partir da próxima coluna
+    void set_trend_column_period_ms(uint32_t period_ms);
+    uint32_t get_trend_column_period_us() const;
     bool is_display_initialized() const { return display_initialized_; }
 
+    // Envio em segundo plano; sem a task, present() envia na hora
+    esp_err_t start_flush_task(UBaseType_t priority, uint32_t stack_size);
+    esp_err_t stop_flush_task();
+    bool is_flush_task_running() const { return flush_task_ != nullptr; }
+    // Há quadro entregue ainda não enviado (ou envio em andamento)
+    bool is_flush_pending() const;
+
+    // Framebuffer de desenho
+    void clear_buffer();
+    // y múltiplo de 8 copia cada glifo direto das colunas da fonte; qualquer outro y
+    // desenha pixel a pixel. Fundo e espaçamento entre glifos são apagados.
+    void draw_text(uint8_t x, uint8_t y, const char* text, const DisplayFont& font = DisplayFont::SMALL);
+    void fill_page_columns(uint8_t page, uint8_t x, uint8_t width, uint8_t pattern);
+    void draw_page_bitmap(uint8_t page, uint8_t x, const uint8_t* columns, uint8_t width);
+    esp_err_t present();
+    const uint8_t* get_framebuffer() const { return &framebuffer_[0][0]; }
+    FlushStats get_flush_stats() const { return flush_stats_; }
+    void reset_flush_stats() { flush_stats_ = {}; }
+
 private:
     I2CManager* i2c_manager_;
     uint8_t device_address_;
     bool display_initialized_;
 
+    static constexpr uint8_t DISPLAY_WIDTH = 128;
+    static constexpr uint8_t DISPLAY_PAGES = 8;
+    static constexpr uint8_t DISPLAY_HEIGHT = DISPLAY_PAGES * 8;
+
+    // Faixa de colunas alterada numa página; first_column == DISPLAY_WIDTH = limpa
+    struct DirtyRange {
+        uint8_t first_column;
+        uint8_t last_column;
+    };
+
+    // Buffer de desenho (só quem desenha mexe)
+    uint8_t framebuffer_[DISPLAY_PAGES][DISPLAY_WIDTH];
+    DirtyRange dirty_[DISPLAY_PAGES];
+    // Buffer da frente, protegido por front_mutex_
+    uint8_t front_buffer_[DISPLAY_PAGES][DISPLAY_WIDTH];
+    DirtyRange front_dirty_[DISPLAY_PAGES];
+    // Página com envio falho: o painel é desconhecido, reenviar sem recorte
+    bool front_resync_[DISPLAY_PAGES];
+    // Conteúdo da GDDRAM; só o envio mexe, e envia a partir daqui
+    uint8_t panel_contents_[DISPLAY_PAGES][DISPLAY_WIDTH];
+    StaticSemaphore_t front_mutex_storage_;
+    SemaphoreHandle_t front_mutex_;
+    TaskHandle_t flush_task_;
+    // "Quadro pronto" para a task de flush: semáforo próprio, porque o envio passa
+    // pela espera síncrona do I2C e não pode ser acordado por um present()
+    StaticSemaphore_t frame_ready_storage_;
+    SemaphoreHandle_t frame_ready_;
+    volatile bool flush_stop_requested_;
+    volatile bool transmitting_;
+    FlushStats flush_stats_;
+
+    // Tela de leituras; entrar nela (depois de outra tela) redesenha tudo
+    LabelWidget temperature_label_;
+    NumericFieldWidget temperature_field_;
+    LabelWidget atmospheric_label_;
+    NumericFieldWidget atmospheric_field_;
+    NumericFieldWidget tire_field_;
+    StatusIconWidget status_icon_;
+    BarGaugeWidget tire_gauge_;
+    NumericFieldWidget tire_psi_field_;
+    WidgetScreen readings_screen_;
+
+    // Tela de tendência: cabeçalho nas páginas 0-1, gráfico nas demais
+    static constexpr uint8_t TREND_FIRST_PAGE = 2;
+    static constexpr uint8_t TREND_LAST_PAGE = DISPLAY_PAGES - 1;
+    static constexpr uint8_t TREND_HEIGHT = (TREND_LAST_PAGE - TREND_FIRST_PAGE + 1) * 8;
+    // Faixa vertical do gráfico; sai dela e a faixa é recentrada no valor novo
+    static constexpr int16_t TREND_SPAN_DECI_KPA = 400;
+    static constexpr uint32_t TREND_DEFAULT_COLUMN_PERIOD_US = 500000;
+    static constexpr int16_t TREND_NO_SAMPLE = INT16_MIN;
+
+    // Mínimo e máximo de uma coluna, em décimos de kPa
+    struct TrendColumn {
+        int16_t min_deci_kpa;
+        int16_t max_deci_kpa;
+    };
+
+    LabelWidget trend_title_;
+    NumericFieldWidget trend_value_field_;
+    LabelWidget trend_scale_label_;
+    WidgetScreen trend_screen_;
+    // Uma entrada por coluna da tela; trend_head_ = cursor (coluna mais nova)
+    TrendColumn trend_columns_[DISPLAY_WIDTH];
+    uint8_t trend_head_;
+    TrendColumn trend_pending_;
+    int16_t trend_floor_deci_kpa_;
+    uint32_t trend_column_period_us_;
+    // Início do período da coluna em acumulação
+    int64_t trend_last_column_us_;
+    bool trend_started_;
+
+    enum class Screen : uint8_t {
+        OTHER,
+        READINGS,
+        TREND,
+    };
+    Screen active_screen_;
+    // Nova tentativa após falha no envio, mesmo sem quadro novo
+    static constexpr uint32_t FLUSH_RETRY_MS = 100;
+    // Fundo de escala da barra da pressão do pneu
+    static constexpr float TIRE_GAUGE_MAX_KPA = 400.0f;
+    static constexpr uint8_t CONTROL_BYTE_COMMAND = 0x00;
+    static constexpr uint8_t CONTROL_BYTE_DATA = 0x40;
+
     esp_err_t send_command(uint8_t command);
     esp_err_t send_data(const uint8_t* data, size_t length);
     esp_err_t send_command_sequence(const uint8_t* commands, size_t length);
-    void draw_text(uint8_t x, uint8_t y, const char* text);
+    esp_err_t set_address_window(uint8_t column_start, uint8_t column_end, uint8_t page_start, uint8_t page_end);
     void draw_horizontal_line(uint8_t x, uint8_t y, uint8_t length);
+    void draw_frame_border();
+    void enter_readings_screen();
+    void enter_trend_screen();
+    void set_active_screen(Screen screen);
+    uint32_t consume_trend_steps();
+    void push_trend_column(const TrendColumn& column);
+    void recenter_trend(int16_t deci_kpa);
+    void draw_trend_graph();
+    void draw_trend_column(uint8_t x, const TrendColumn& column);
+    uint8_t trend_row(int16_t deci_kpa) const;
+    void draw_centered_text(uint8_t y, const char* text, const DisplayFont& font = DisplayFont::SMALL);
+    void draw_wrapped_text(uint8_t first_page, uint8_t last_page, const char* text);
+    void blit_glyph(uint8_t x, uint8_t page, uint8_t width, const uint8_t* glyph, const DisplayFont& font);
+    void plot_glyph(uint8_t x, uint8_t y, uint8_t width, const uint8_t* glyph, const DisplayFont& font);
+
+    void write_column_byte(uint8_t page, uint8_t column, uint8_t value);
+    void mark_dirty(uint8_t page, uint8_t first_column, uint8_t last_column);
+    void set_pixel(uint8_t x, uint8_t y, bool on);
+    void mark_clean(uint8_t page);
+    void invalidate_all();
+
+    esp_err_t transmit_front();
+    void requeue_windows(const DirtyRange* windows, uint8_t first_page);
+    static void flush_task(void* arg);
+    static void merge_range(DirtyRange& range, uint8_t first_column, uint8_t last_column);
+    static void trim_range(DirtyRange& range, const uint8_t* wanted, const uint8_t* panel);
 };
\ No newline at end of file
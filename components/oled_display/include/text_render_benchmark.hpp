@@ -0,0 +1,29 @@
+#pragma once
+#include "oled_display.hpp"
+
+// Custo de desenhar texto no framebuffer, sem barramento: a mesma string numa
+// linha alinhada a página (memcpy das colunas da fonte) e deslocada de um pixel
+// (caminho genérico, pixel a pixel). Desenha no framebuffer do display recebido e
+// limpa a tela no fim (clear_display): os widgets da tela ativa achariam que ainda
+// estão desenhados, então a próxima tela precisa entrar do zero.
+class TextRenderBenchmark {
+public:
+    struct Result {
+        const char* name;
+        uint32_t glyphs;
+        float ns_per_glyph;
+    };
+
+    static constexpr uint32_t DEFAULT_ITERATIONS = 2000;
+
+    explicit TextRenderBenchmark(OLEDDisplay* display);
+
+    Result run(const char* name, const char* text, const DisplayFont& font, uint8_t y,
+               uint32_t iterations = DEFAULT_ITERATIONS);
+    void log_result(const Result& result) const;
+    // Fonte pequena e grande, alinhada e deslocada
+    void run_standard_suite();
+
+private:
+    OLEDDisplay* display_;
+};
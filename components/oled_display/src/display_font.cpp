@@ -0,0 +1,150 @@
+#include "display_font.hpp"
+
+// Fonte 5x7: uma linha por glifo, sete linhas de 5 bits (bit 4 = coluna da esquerda)
+static constexpr uint8_t SMALL_WIDTH = 5;
+static constexpr uint8_t SMALL_HEIGHT = 7;
+static constexpr char SMALL_FIRST = ' ';
+static constexpr char SMALL_LAST = '_';
+static constexpr size_t SMALL_GLYPHS = SMALL_LAST - SMALL_FIRST + 1;
+
+static constexpr uint8_t SMALL_ROWS[SMALL_GLYPHS][SMALL_HEIGHT] = {
+    {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000}, // ' '
+    {0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00000, 0b00100}, // '!'
+    {0b01010, 0b01010, 0b01010, 0b00000, 0b00000, 0b00000, 0b00000}, // '"'
+    {0b01010, 0b01010, 0b11111, 0b01010, 0b11111, 0b01010, 0b01010}, // '#'
+    {0b00100, 0b01111, 0b10100, 0b01110, 0b00101, 0b11110, 0b00100}, // '$'
+    {0b11000, 0b11001, 0b00010, 0b00100, 0b01000, 0b10011, 0b00011}, // '%'
+    {0b01100, 0b10010, 0b10100, 0b01000, 0b10101, 0b10010, 0b01101}, // '&'
+    {0b00100, 0b00100, 0b01000, 0b00000, 0b00000, 0b00000, 0b00000}, // '''
+    {0b00010, 0b00100, 0b01000, 0b01000, 0b01000, 0b00100, 0b00010}, // '('
+    {0b01000, 0b00100, 0b00010, 0b00010, 0b00010, 0b00100, 0b01000}, // ')'
+    {0b00000, 0b00100, 0b10101, 0b01110, 0b10101, 0b00100, 0b00000}, // '*'
+    {0b00000, 0b00100, 0b00100, 0b11111, 0b00100, 0b00100, 0b00000}, // '+'
+    {0b00000, 0b00000, 0b00000, 0b00000, 0b01100, 0b00100, 0b01000}, // ','
+    {0b00000, 0b00000, 0b00000, 0b11111, 0b00000, 0b00000, 0b00000}, // '-'
+    {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b01100, 0b01100}, // '.'
+    {0b00000, 0b00001, 0b00010, 0b00100, 0b01000, 0b10000, 0b00000}, // '/'
+    {0b01110, 0b10001, 0b10011, 0b10101, 0b11001, 0b10001, 0b01110}, // '0'
+    {0b00100, 0b01100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110}, // '1'
+    {0b01110, 0b10001, 0b00001, 0b00010, 0b00100, 0b01000, 0b11111}, // '2'
+    {0b11111, 0b00010, 0b00100, 0b00010, 0b00001, 0b10001, 0b01110}, // '3'
+    {0b00010, 0b00110, 0b01010, 0b10010, 0b11111, 0b00010, 0b00010}, // '4'
+    {0b11111, 0b10000, 0b11110, 0b00001, 0b00001, 0b10001, 0b01110}, // '5'
+    {0b00110, 0b01000, 0b10000, 0b11110, 0b10001, 0b10001, 0b01110}, // '6'
+    {0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b01000, 0b01000}, // '7'
+    {0b01110, 0b10001, 0b10001, 0b01110, 0b10001, 0b10001, 0b01110}, // '8'
+    {0b01110, 0b10001, 0b10001, 0b01111, 0b00001, 0b00010, 0b01100}, // '9'
+    {0b00000, 0b01100, 0b01100, 0b00000, 0b01100, 0b01100, 0b00000}, // ':'
+    {0b00000, 0b01100, 0b01100, 0b00000, 0b01100, 0b00100, 0b01000}, // ';'
+    {0b00010, 0b00100, 0b01000, 0b10000, 0b01000, 0b00100, 0b00010}, // '<'
+    {0b00000, 0b00000, 0b11111, 0b00000, 0b11111, 0b00000, 0b00000}, // '='
+    {0b01000, 0b00100, 0b00010, 0b00001, 0b00010, 0b00100, 0b01000}, // '>'
+    {0b01110, 0b10001, 0b00001, 0b00010, 0b00100, 0b00000, 0b00100}, // '?'
+    {0b01110, 0b10001, 0b00001, 0b01101, 0b10101, 0b10101, 0b01110}, // '@'
+    {0b01110, 0b10001, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001}, // 'A'
+    {0b11110, 0b10001, 0b10001, 0b11110, 0b10001, 0b10001, 0b11110}, // 'B'
+    {0b01110, 0b10001, 0b10000, 0b10000, 0b10000, 0b10001, 0b01110}, // 'C'
+    {0b11100, 0b10010, 0b10001, 0b10001, 0b10001, 0b10010, 0b11100}, // 'D'
+    {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b11111}, // 'E'
+    {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b10000}, // 'F'
+    {0b01110, 0b10001, 0b10000, 0b10111, 0b10001, 0b10001, 0b01111}, // 'G'
+    {0b10001, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001, 0b10001}, // 'H'
+    {0b01110, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110}, // 'I'
+    {0b00111, 0b00010, 0b00010, 0b00010, 0b00010, 0b10010, 0b01100}, // 'J'
+    {0b10001, 0b10010, 0b10100, 0b11000, 0b10100, 0b10010, 0b10001}, // 'K'
+    {0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b11111}, // 'L'
+    {0b10001, 0b11011, 0b10101, 0b10101, 0b10001, 0b10001, 0b10001}, // 'M'
+    {0b10001, 0b10001, 0b11001, 0b10101, 0b10011, 0b10001, 0b10001}, // 'N'
+    {0b01110, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110}, // 'O'
+    {0b11110, 0b10001, 0b10001, 0b11110, 0b10000, 0b10000, 0b10000}, // 'P'
+    {0b01110, 0b10001, 0b10001, 0b10001, 0b10101, 0b10010, 0b01101}, // 'Q'
+    {0b11110, 0b10001, 0b10001, 0b11110, 0b10100, 0b10010, 0b10001}, // 'R'
+    {0b01111, 0b10000, 0b10000, 0b01110, 0b00001, 0b00001, 0b11110}, // 'S'
+    {0b11111, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100}, // 'T'
+    {0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110}, // 'U'
+    {0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01010, 0b00100}, // 'V'
+    {0b10001, 0b10001, 0b10001, 0b10101, 0b10101, 0b10101, 0b01010}, // 'W'
+    {0b10001, 0b10001, 0b01010, 0b00100, 0b01010, 0b10001, 0b10001}, // 'X'
+    {0b10001, 0b10001, 0b10001, 0b01010, 0b00100, 0b00100, 0b00100}, // 'Y'
+    {0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b10000, 0b11111}, // 'Z'
+    {0b01110, 0b01000, 0b01000, 0b01000, 0b01000, 0b01000, 0b01110}, // '['
+    {0b00000, 0b10000, 0b01000, 0b00100, 0b00010, 0b00001, 0b00000}, // '\'
+    {0b01110, 0b00010, 0b00010, 0b00010, 0b00010, 0b00010, 0b01110}, // ']'
+    {0b00100, 0b01010, 0b10001, 0b00000, 0b00000, 0b00000, 0b00000}, // '^'
+    {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b11111}, // '_'
+};
+
+static constexpr PackedFont<SMALL_WIDTH, SMALL_HEIGHT, SMALL_GLYPHS> SMALL_PACKED =
+    pack_font<SMALL_WIDTH, SMALL_HEIGHT, SMALL_GLYPHS>([](size_t glyph, uint8_t x, uint8_t y) {
+        return ((SMALL_ROWS[glyph][y] >> (SMALL_WIDTH - 1 - x)) & 1) != 0;
+    });
+
+// Algarismos grandes em sete segmentos, traço de 2 pixels. A linha 15 fica
+// vazia para separar o valor do que vier na página de baixo.
+static constexpr uint8_t LARGE_WIDTH = 10;
+static constexpr uint8_t LARGE_HEIGHT = 16;
+static constexpr char LARGE_FIRST = '-';
+static constexpr char LARGE_LAST = '9';
+static constexpr size_t LARGE_GLYPHS = LARGE_LAST - LARGE_FIRST + 1;
+
+enum Segment : uint8_t {
+    SEG_A = 1 << 0, // topo
+    SEG_B = 1 << 1, // direita de cima
+    SEG_C = 1 << 2, // direita de baixo
+    SEG_D = 1 << 3, // base
+    SEG_E = 1 << 4, // esquerda de baixo
+    SEG_F = 1 << 5, // esquerda de cima
+    SEG_G = 1 << 6, // meio
+    SEG_POINT = 1 << 7,
+};
+
+static constexpr uint8_t LARGE_SEGMENTS[LARGE_GLYPHS] = {
+    SEG_G,                                             // '-'
+    SEG_POINT,                                         // '.'
+    0,                                                 // '/' (sem glifo)
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F,     // '0'
+    SEG_B | SEG_C,                                     // '1'
+    SEG_A | SEG_B | SEG_G | SEG_E | SEG_D,             // '2'
+    SEG_A | SEG_B | SEG_G | SEG_C | SEG_D,             // '3'
+    SEG_F | SEG_G | SEG_B | SEG_C,                     // '4'
+    SEG_A | SEG_F | SEG_G | SEG_C | SEG_D,             // '5'
+    SEG_A | SEG_F | SEG_G | SEG_E | SEG_C | SEG_D,     // '6'
+    SEG_A | SEG_B | SEG_C,                             // '7'
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G, // '8'
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_F | SEG_G,     // '9'
+};
+
+static constexpr bool seven_segment_pixel(uint8_t segments, uint8_t x, uint8_t y) {
+    const bool left = x <= 1;
+    const bool right = x >= LARGE_WIDTH - 2;
+    const bool inner = x >= 1 && x <= LARGE_WIDTH - 2;
+    const bool upper = y >= 1 && y <= 7;
+    const bool lower = y >= 8 && y <= 13;
+
+    return ((segments & SEG_A) && inner && y <= 1) ||
+           ((segments & SEG_G) && inner && (y == 7 || y == 8)) ||
+           ((segments & SEG_D) && inner && (y == 13 || y == 14)) ||
+           ((segments & SEG_F) && left && upper) ||
+           ((segments & SEG_B) && right && upper) ||
+           ((segments & SEG_E) && left && lower) ||
+           ((segments & SEG_C) && right && lower) ||
+           ((segments & SEG_POINT) && (x == 4 || x == 5) && (y == 13 || y == 14));
+}
+
+static constexpr PackedFont<LARGE_WIDTH, LARGE_HEIGHT, LARGE_GLYPHS> LARGE_PACKED =
+    pack_font<LARGE_WIDTH, LARGE_HEIGHT, LARGE_GLYPHS>([](size_t glyph, uint8_t x, uint8_t y) {
+        return seven_segment_pixel(LARGE_SEGMENTS[glyph], x, y);
+    });
+
+// Conferência em tempo de compilação: '0' da fonte pequena, coluna da esquerda = linhas 1..5
+static_assert(SMALL_PACKED.data[('0' - SMALL_FIRST) * SMALL_WIDTH] == 0b00111110, "empacotamento da fonte 5x7");
+
+const DisplayFont DisplayFont::SMALL = {
+    SMALL_PACKED.data, SMALL_WIDTH, SMALL_HEIGHT, PackedFont<SMALL_WIDTH, SMALL_HEIGHT, SMALL_GLYPHS>::PAGES,
+    1, SMALL_FIRST, SMALL_LAST, '?', true,
+};
+
+const DisplayFont DisplayFont::LARGE_NUMERIC = {
+    LARGE_PACKED.data, LARGE_WIDTH, LARGE_HEIGHT, PackedFont<LARGE_WIDTH, LARGE_HEIGHT, LARGE_GLYPHS>::PAGES,
+    2, LARGE_FIRST, LARGE_LAST, '\0', false,
+};
@@ -0,0 +1,187 @@
+#include "display_widgets.hpp"
+#include "oled_display.hpp"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Ícones no formato de página: um byte por coluna, bit 0 em cima
+static const uint8_t ICON_OK[8] = {0x10, 0x30, 0x60, 0x30, 0x18, 0x0C, 0x06, 0x02};
+static const uint8_t ICON_WARNING[8] = {0xC0, 0xF0, 0xFC, 0xA3, 0xA3, 0xFC, 0xF0, 0xC0};
+static const uint8_t ICON_ERROR[8] = {0x81, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x81};
+
+// Moldura da barra: colunas das pontas cheias, por dentro linhas de cima e de baixo
+static constexpr uint8_t GAUGE_END = 0xFF;
+static constexpr uint8_t GAUGE_EMPTY = 0x81;
+static constexpr uint8_t GAUGE_FILLED = 0xBD;
+// Colunas entre o valor e a unidade
+static constexpr uint8_t UNIT_GAP = 3;
+
+Widget::Widget(uint8_t x, uint8_t page, uint8_t width, uint8_t pages)
+    : x_(x), page_(page), width_(width), pages_(pages), dirty_(true) {}
+
+void Widget::render(OLEDDisplay& display) {
+    for (uint8_t page = page_; page < page_ + pages_; page++) {
+        display.fill_page_columns(page, x_, width_, 0x00);
+    }
+    draw(display);
+    dirty_ = false;
+}
+
+bool QuantizedValue::update(float steps) {
+    if (isnan(steps)) {
+        return false;
+    }
+
+    if (!valid_) {
+        steps_ = (int32_t)lroundf(steps);
+        valid_ = true;
+        return true;
+    }
+
+    int32_t rounded = (int32_t)lroundf(steps);
+    if (rounded == steps_ || fabsf(steps - (float)steps_) < 0.5f + hysteresis_steps_) {
+        return false;
+    }
+    steps_ = rounded;
+    return true;
+}
+
+LabelWidget::LabelWidget(uint8_t x, uint8_t page, uint8_t width, const DisplayFont& font)
+    : Widget(x, page, width, font.pages), font_(&font), text_{} {}
+
+void LabelWidget::set_text(const char* text) {
+    if (text == nullptr || strncmp(text, text_, MAX_TEXT) == 0) {
+        return;
+    }
+    strncpy(text_, text, MAX_TEXT);
+    text_[MAX_TEXT] = '\0';
+    invalidate();
+}
+
+void LabelWidget::draw(OLEDDisplay& display) {
+    display.draw_text(x_, page_ * 8, text_, *font_);
+}
+
+NumericFieldWidget::NumericFieldWidget(uint8_t x, uint8_t page, uint8_t width, const DisplayFont& font,
+                                       uint8_t precision, const char* unit, float hysteresis_steps)
+    : Widget(x, page, width, font.pages), font_(&font),
+      precision_((precision > MAX_PRECISION) ? MAX_PRECISION : precision), scale_(1.0f),
+      unit_((unit != nullptr) ? unit : ""), value_(hysteresis_steps) {
+    for (uint8_t i = 0; i < precision_; i++) {
+        scale_ *= 10.0f;
+    }
+}
+
+void NumericFieldWidget::set_value(float value) {
+    if (value_.update(value * scale_)) {
+        invalidate();
+    }
+}
+
+void NumericFieldWidget::set_unavailable() {
+    if (value_.is_valid()) {
+        value_.reset();
+        invalidate();
+    }
+}
+
+void NumericFieldWidget::draw(OLEDDisplay& display) {
+    char text[16];
+    if (value_.is_valid()) {
+        // Formata o degrau guardado, não a leitura: a tela mostra exatamente o valor quantizado
+        snprintf(text, sizeof(text), "%.*f", (int)precision_, (double)((float)value_.get_steps() / scale_));
+    } else {
+        snprintf(text, sizeof(text), "--");
+    }
+
+    uint16_t unit_width = DisplayFont::SMALL.measure(unit_);
+    uint16_t value_width = font_->measure(text);
+    uint16_t reserved = (unit_width > 0) ? unit_width + UNIT_GAP : 0;
+
+    uint8_t value_x = (value_width + reserved < width_) ? (uint8_t)(x_ + width_ - reserved - value_width) : x_;
+    display.draw_text(value_x, page_ * 8, text, *font_);
+    if (unit_width > 0 && unit_width <= width_) {
+        display.draw_text((uint8_t)(x_ + width_ - unit_width), (page_ + pages_ - 1) * 8, unit_);
+    }
+}
+
+BarGaugeWidget::BarGaugeWidget(uint8_t x, uint8_t page, uint8_t width, float min_value, float max_value,
+                               float hysteresis_steps)
+    : Widget(x, page, (width < 3) ? 3 : width, 1), min_value_(min_value),
+      max_value_((max_value > min_value) ? max_value : min_value + 1.0f), filled_columns_(hysteresis_steps) {}
+
+void BarGaugeWidget::set_value(float value) {
+    const uint8_t inner_columns = width_ - 2;
+    float fraction = (value - min_value_) / (max_value_ - min_value_);
+    fraction = (fraction < 0.0f) ? 0.0f : ((fraction > 1.0f) ? 1.0f : fraction);
+
+    if (filled_columns_.update(fraction * inner_columns)) {
+        invalidate();
+    }
+}
+
+void BarGaugeWidget::draw(OLEDDisplay& display) {
+    const uint8_t inner_columns = width_ - 2;
+    int32_t filled = filled_columns_.is_valid() ? filled_columns_.get_steps() : 0;
+    filled = (filled > inner_columns) ? inner_columns : filled;
+
+    display.fill_page_columns(page_, x_, 1, GAUGE_END);
+    display.fill_page_columns(page_, x_ + 1, (uint8_t)filled, GAUGE_FILLED);
+    display.fill_page_columns(page_, x_ + 1 + filled, (uint8_t)(inner_columns - filled), GAUGE_EMPTY);
+    display.fill_page_columns(page_, x_ + width_ - 1, 1, GAUGE_END);
+}
+
+StatusIconWidget::StatusIconWidget(uint8_t x, uint8_t page) : Widget(x, page, 8, 1), icon_(Icon::NONE) {}
+
+void StatusIconWidget::set_icon(Icon icon) {
+    if (icon != icon_) {
+        icon_ = icon;
+        invalidate();
+    }
+}
+
+void StatusIconWidget::draw(OLEDDisplay& display) {
+    switch (icon_) {
+        case Icon::OK:
+            display.draw_page_bitmap(page_, x_, ICON_OK, sizeof(ICON_OK));
+            break;
+        case Icon::WARNING:
+            display.draw_page_bitmap(page_, x_, ICON_WARNING, sizeof(ICON_WARNING));
+            break;
+        case Icon::ERROR:
+            display.draw_page_bitmap(page_, x_, ICON_ERROR, sizeof(ICON_ERROR));
+            break;
+        default:
+            break;
+    }
+}
+
+WidgetScreen::WidgetScreen() : widgets_{}, widget_count_(0) {}
+
+esp_err_t WidgetScreen::add(Widget* widget) {
+    if (widget == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (widget_count_ >= MAX_WIDGETS) {
+        return ESP_ERR_NO_MEM;
+    }
+    widgets_[widget_count_++] = widget;
+    return ESP_OK;
+}
+
+void WidgetScreen::invalidate_all() {
+    for (size_t i = 0; i < widget_count_; i++) {
+        widgets_[i]->invalidate();
+    }
+}
+
+size_t WidgetScreen::render(OLEDDisplay& display) {
+    size_t rendered = 0;
+    for (size_t i = 0; i < widget_count_; i++) {
+        if (widgets_[i]->is_dirty()) {
+            widgets_[i]->render(display);
+            rendered++;
+        }
+    }
+    return rendered;
+}
@@ -1,5 +1,8 @@
 #include "oled_display.hpp"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include <math.h>
+#include <stdio.h>
 #include <string.h>
 
 static const char *TAG = "OLEDDisplay";
@@ -7,6 +10,7 @@ static const char *TAG = "OLEDDisplay";
 // Sequência de inicialização do SSD1306
 static const uint8_t INIT_COMMANDS[] = {
     0xAE, // Display OFF
+    0x2E, // Deactivate scroll (pode ter ficado ligado antes de um reset do ESP32)
     0x20, 0x00, // Memory addressing mode = horizontal
     0x21, 0x00, 0x7F, // Column address range
     0x22, 0x00, 0x07, // Page address range
@@ -25,9 +29,45 @@ static const uint8_t INIT_COMMANDS[] = {
 };
 
 OLEDDisplay::OLEDDisplay(I2CManager* i2c_manager, uint8_t device_address) 
-    : i2c_manager_(i2c_manager), device_address_(device_address), display_initialized_(false) {}
+    : i2c_manager_(i2c_manager), device_address_(device_address), display_initialized_(false),
+      front_resync_{}, front_mutex_(nullptr), flush_task_(nullptr), frame_ready_(nullptr),
+      flush_stop_requested_(false), transmitting_(false), flush_stats_{},
+      temperature_label_(0, 1, 30), temperature_field_(30, 1, 98, DisplayFont::SMALL, 1, "C"),
+      atmospheric_label_(0, 2, 30), atmospheric_field_(30, 2, 98, DisplayFont::SMALL, 1, "hPa"),
+      tire_field_(0, 3, 112, DisplayFont::LARGE_NUMERIC, 2, "bar"), status_icon_(120, 3),
+      tire_gauge_(0, 5, DISPLAY_WIDTH, 0.0f, TIRE_GAUGE_MAX_KPA),
+      tire_psi_field_(30, 6, 98, DisplayFont::SMALL, 1, "PSI"),
+      trend_title_(0, 0, 54), trend_value_field_(54, 0, 74, DisplayFont::SMALL, 1, "kPa"),
+      trend_scale_label_(0, 1, DISPLAY_WIDTH), trend_head_(DISPLAY_WIDTH - 1),
+      trend_pending_{TREND_NO_SAMPLE, TREND_NO_SAMPLE}, trend_floor_deci_kpa_(TREND_NO_SAMPLE),
+      trend_column_period_us_(TREND_DEFAULT_COLUMN_PERIOD_US), trend_last_column_us_(0), trend_started_(false),
+      active_screen_(Screen::OTHER) {
+    temperature_label_.set_text("Temp");
+    atmospheric_label_.set_text("Atm");
+    readings_screen_.add(&temperature_label_);
+    readings_screen_.add(&temperature_field_);
+    readings_screen_.add(&atmospheric_label_);
+    readings_screen_.add(&atmospheric_field_);
+    readings_screen_.add(&tire_field_);
+    readings_screen_.add(&status_icon_);
+    readings_screen_.add(&tire_gauge_);
+    readings_screen_.add(&tire_psi_field_);
+    trend_title_.set_text("Tendencia");
+    trend_screen_.add(&trend_title_);
+    trend_screen_.add(&trend_value_field_);
+    trend_screen_.add(&trend_scale_label_);
+
+    memset(framebuffer_, 0, sizeof(framebuffer_));
+    memset(front_buffer_, 0, sizeof(front_buffer_));
+    memset(panel_contents_, 0, sizeof(panel_contents_));
+    for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+        mark_clean(page);
+        front_dirty_[page] = dirty_[page];
+    }
+}
 
 OLEDDisplay::~OLEDDisplay() {
+    stop_flush_task();
     if (display_initialized_) {
         send_command(0xAE); // Display OFF
         ESP_LOGI(TAG, "Display OLED finalizado");
@@ -35,27 +75,26 @@ OLEDDisplay::~OLEDDisplay() {
 }
 
 esp_err_t OLEDDisplay::send_command(uint8_t command) {
-    uint8_t buffer[2] = {0x00, command}; // 0x00 = command mode
-    return i2c_manager_->write_register(device_address_, buffer[0], buffer[1]);
+    return i2c_manager_->write_register(device_address_, CONTROL_BYTE_COMMAND, command);
 }
 
 esp_err_t OLEDDisplay::send_data(const uint8_t* data, size_t length) {
-    esp_err_t result = ESP_OK;
-    for (size_t i = 0; i < length; i++) {
-        result = i2c_manager_->write_register(device_address_, 0x40, data[i]); // 0x40 = data mode
-        if (result != ESP_OK) break;
-    }
-    return result;
+    // Uma única transação: byte de controle 0x40 seguido de todo o payload
+    return i2c_manager_->write_register_block(device_address_, CONTROL_BYTE_DATA, data, length);
 }
 
 esp_err_t OLEDDisplay::send_command_sequence(const uint8_t* commands, size_t length) {
-    esp_err_t result = ESP_OK;
-    for (size_t i = 0; i < length; i++) {
-        result = send_command(commands[i]);
-        if (result != ESP_OK) break;
-        vTaskDelay(pdMS_TO_TICKS(1)); // Pequeno delay entre comandos
-    }
-    return result;
+    // Com Co=0 o SSD1306 aceita vários comandos após um único byte de controle
+    return i2c_manager_->write_register_block(device_address_, CONTROL_BYTE_COMMAND, commands, length);
+}
+
+esp_err_t OLEDDisplay::set_address_window(uint8_t column_start, uint8_t column_end,
+                                          uint8_t page_start, uint8_t page_end) {
+    const uint8_t window_commands[] = {
+        0x21, column_start, column_end, // Column address range
+        0x22, page_start, page_end,     // Page address range
+    };
+    return send_command_sequence(window_commands, sizeof(window_commands));
 }
 
 esp_err_t OLEDDisplay::initialize_display() {
@@ -68,6 +107,13 @@ esp_err_t OLEDDisplay::initialize_display() {
         return probe_result;
     }
 
+    // Escritas de pixels são a classe de menor prioridade e podem ser divididas em pedaços;
+    // as sequências de comando do display cabem num único pedaço
+    i2c_manager_->set_device_priority(device_address_, I2CManager::BusPriority::DISPLAY_FLUSH, true);
+
+    // O SSD1306 é especificado até 400 kHz
+    i2c_manager_->set_device_max_speed(device_address_, I2CManager::BusSpeed::FAST);
+
     // Enviar sequência de inicialização
     esp_err_t init_result = send_command_sequence(INIT_COMMANDS, sizeof(INIT_COMMANDS));
     if (init_result != ESP_OK) {
@@ -75,10 +121,22 @@ esp_err_t OLEDDisplay::initialize_display() {
         return init_result;
     }
 
-    // Limpar display
-    clear_display();
-
+    if (front_mutex_ == nullptr) {
+        front_mutex_ = xSemaphoreCreateMutexStatic(&front_mutex_storage_);
+        frame_ready_ = xSemaphoreCreateBinaryStatic(&frame_ready_storage_);
+    }
     display_initialized_ = true;
+
+    // A GDDRAM tem conteúdo indefinido após o reset: a primeira escrita é a tela inteira
+    memset(framebuffer_, 0, sizeof(framebuffer_));
+    invalidate_all();
+    esp_err_t flush_result = present();
+    if (flush_result != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao limpar display OLED");
+        display_initialized_ = false;
+        return flush_result;
+    }
+
     ESP_LOGI(TAG, "Display OLED inicializado com sucesso");
     return ESP_OK;
 }
@@ -86,96 +144,591 @@ esp_err_t OLEDDisplay::initialize_display() {
 void OLEDDisplay::clear_display() {
     if (!display_initialized_) return;
 
-    // Limpar toda a memória do display (128x64 pixels = 1024 bytes)
-    uint8_t zero_buffer[128] = {0};
-    
-    for (uint8_t page = 0; page < 8; page++) {
-        // Configurar endereço de página
-        send_command(0xB0 + page); // Set page address
-        send_command(0x00);        // Set lower column address
-        send_command(0x10);        // Set higher column address
-        
-        // Enviar 128 bytes de zeros para esta página
-        send_data(zero_buffer, 128);
+    set_active_screen(Screen::OTHER);
+    clear_buffer();
+    present();
+}
+
+void OLEDDisplay::clear_buffer() {
+    for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+        for (uint8_t column = 0; column < DISPLAY_WIDTH; column++) {
+            write_column_byte(page, column, 0x00);
+        }
+    }
+}
+
+void OLEDDisplay::write_column_byte(uint8_t page, uint8_t column, uint8_t value) {
+    if (page >= DISPLAY_PAGES || column >= DISPLAY_WIDTH || framebuffer_[page][column] == value) {
+        return;
+    }
+
+    framebuffer_[page][column] = value;
+    mark_dirty(page, column, column);
+}
+
+void OLEDDisplay::mark_dirty(uint8_t page, uint8_t first_column, uint8_t last_column) {
+    merge_range(dirty_[page], first_column, last_column);
+}
+
+void OLEDDisplay::merge_range(DirtyRange& range, uint8_t first_column, uint8_t last_column) {
+    if (first_column < range.first_column) {
+        range.first_column = first_column;
+    }
+    if (range.last_column == DISPLAY_WIDTH || last_column > range.last_column) {
+        range.last_column = last_column;
     }
 }
 
-void OLEDDisplay::draw_text(uint8_t x, uint8_t y, const char* text) {
-    if (!display_initialized_ || text == nullptr) return;
+void OLEDDisplay::set_pixel(uint8_t x, uint8_t y, bool on) {
+    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return;
 
-    // Implementação básica de texto - apenas para demonstração
-    // Em uma implementação real, precisaríamos de uma fonte
-    ESP_LOGI(TAG, "Texto no display [%d,%d]: %s", x, y, text);
+    uint8_t page = y / 8;
+    uint8_t mask = (uint8_t)(1u << (y % 8));
+    uint8_t value = on ? (framebuffer_[page][x] | mask) : (framebuffer_[page][x] & ~mask);
+    write_column_byte(page, x, value);
+}
+
+void OLEDDisplay::mark_clean(uint8_t page) {
+    dirty_[page].first_column = DISPLAY_WIDTH;
+    dirty_[page].last_column = DISPLAY_WIDTH;
+}
+
+// Descarta das pontas da faixa as colunas que já estão iguais no painel
+void OLEDDisplay::trim_range(DirtyRange& range, const uint8_t* wanted, const uint8_t* panel) {
+    if (range.first_column >= DISPLAY_WIDTH) return;
+
+    while (range.first_column <= range.last_column && wanted[range.first_column] == panel[range.first_column]) {
+        range.first_column++;
+    }
+    while (range.last_column > range.first_column && wanted[range.last_column] == panel[range.last_column]) {
+        range.last_column--;
+    }
+
+    if (range.first_column > range.last_column) {
+        range.first_column = DISPLAY_WIDTH;
+        range.last_column = DISPLAY_WIDTH;
+    }
+}
+
+// Tela inteira para o próximo envio, sem recorte (conteúdo do painel desconhecido)
+void OLEDDisplay::invalidate_all() {
+    for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+        dirty_[page].first_column = 0;
+        dirty_[page].last_column = DISPLAY_WIDTH - 1;
+        front_resync_[page] = true;
+    }
+}
+
+// Entrega o buffer de desenho: só as faixas alteradas são copiadas para a frente,
+// sob o mutex. Com a task de flush o envio fica com ela; sem a task, envia aqui.
+esp_err_t OLEDDisplay::present() {
+    if (!display_initialized_) return ESP_ERR_INVALID_STATE;
+
+    xSemaphoreTake(front_mutex_, portMAX_DELAY);
+    bool frame_pending = false;
+    for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+        frame_pending |= front_dirty_[page].first_column < DISPLAY_WIDTH;
+
+        const DirtyRange range = dirty_[page];
+        if (range.first_column >= DISPLAY_WIDTH) continue;
+
+        memcpy(&front_buffer_[page][range.first_column], &framebuffer_[page][range.first_column],
+               range.last_column - range.first_column + 1);
+        merge_range(front_dirty_[page], range.first_column, range.last_column);
+        mark_clean(page);
+    }
+    flush_stats_.presents++;
+    if (frame_pending) {
+        flush_stats_.merged_frames++;
+    }
+    xSemaphoreGive(front_mutex_);
+
+    if (flush_task_ != nullptr) {
+        xSemaphoreGive(frame_ready_);
+        return ESP_OK;
+    }
+    return transmit_front();
+}
+
+// Sob o mutex: recorta as faixas da frente contra o painel e as copia para
+// panel_contents_, que vira a origem do envio. O I2C corre sem o mutex, então
+// present() nunca espera pelo barramento.
+esp_err_t OLEDDisplay::transmit_front() {
+    DirtyRange windows[DISPLAY_PAGES];
+
+    xSemaphoreTake(front_mutex_, portMAX_DELAY);
+    transmitting_ = true;
+    for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+        windows[page] = front_dirty_[page];
+        if (!front_resync_[page]) {
+            trim_range(windows[page], front_buffer_[page], panel_contents_[page]);
+        }
+        if (windows[page].first_column < DISPLAY_WIDTH) {
+            memcpy(&panel_contents_[page][windows[page].first_column], &front_buffer_[page][windows[page].first_column],
+                   windows[page].last_column - windows[page].first_column + 1);
+        }
+        front_dirty_[page].first_column = DISPLAY_WIDTH;
+        front_dirty_[page].last_column = DISPLAY_WIDTH;
+        front_resync_[page] = false;
+    }
+    xSemaphoreGive(front_mutex_);
+
+    // Uma janela 0x21/0x22 por grupo de páginas consecutivas com a mesma faixa de
+    // colunas (texto de duas páginas vira uma janela só) e uma transação de dados por página
+    flush_stats_.flushes++;
+    bool sent = false;
+    uint8_t page = 0;
+    esp_err_t result = ESP_OK;
+    while (page < DISPLAY_PAGES) {
+        const DirtyRange range = windows[page];
+        if (range.first_column >= DISPLAY_WIDTH) {
+            page++;
+            continue;
+        }
+
+        uint8_t last_page = page;
+        while (last_page + 1 < DISPLAY_PAGES && windows[last_page + 1].first_column == range.first_column &&
+               windows[last_page + 1].last_column == range.last_column) {
+            last_page++;
+        }
+
+        result = set_address_window(range.first_column, range.last_column, page, last_page);
+        size_t length = range.last_column - range.first_column + 1;
+        for (uint8_t window_page = page; window_page <= last_page && result == ESP_OK; window_page++) {
+            result = send_data(&panel_contents_[window_page][range.first_column], length);
+            if (result == ESP_OK) {
+                flush_stats_.data_bytes += length;
+                windows[window_page].first_column = DISPLAY_WIDTH;
+            }
+        }
+        if (result != ESP_OK) {
+            break;
+        }
+
+        flush_stats_.windows++;
+        sent = true;
+        page = last_page + 1;
+    }
+
+    if (result != ESP_OK) {
+        // Páginas não enviadas voltam para a frente e serão reenviadas inteiras
+        flush_stats_.send_errors++;
+        requeue_windows(windows, page);
+    } else if (!sent) {
+        flush_stats_.empty_flushes++;
+    }
+
+    transmitting_ = false;
+    return result;
+}
+
+void OLEDDisplay::requeue_windows(const DirtyRange* windows, uint8_t first_page) {
+    xSemaphoreTake(front_mutex_, portMAX_DELAY);
+    for (uint8_t page = first_page; page < DISPLAY_PAGES; page++) {
+        if (windows[page].first_column >= DISPLAY_WIDTH) continue;
+
+        merge_range(front_dirty_[page], windows[page].first_column, windows[page].last_column);
+        front_resync_[page] = true;
+    }
+    xSemaphoreGive(front_mutex_);
+}
+
+bool OLEDDisplay::is_flush_pending() const {
+    if (transmitting_) {
+        return true;
+    }
+    for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+        if (front_dirty_[page].first_column < DISPLAY_WIDTH) {
+            return true;
+        }
+    }
+    return false;
+}
+
+esp_err_t OLEDDisplay::start_flush_task(UBaseType_t priority, uint32_t stack_size) {
+    if (!display_initialized_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (flush_task_ != nullptr) {
+        return ESP_OK;
+    }
+
+    flush_stop_requested_ = false;
+    if (xTaskCreate(flush_task, "oled_flush", stack_size, this, priority, &flush_task_) != pdPASS) {
+        ESP_LOGE(TAG, "Falha ao criar task de flush");
+        flush_task_ = nullptr;
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "Task de flush do display iniciada");
+    return ESP_OK;
+}
+
+esp_err_t OLEDDisplay::stop_flush_task() {
+    if (flush_task_ == nullptr) {
+        return ESP_OK;
+    }
+
+    // A task termina o envio em andamento e se apaga
+    flush_stop_requested_ = true;
+    xSemaphoreGive(frame_ready_);
+    while (flush_task_ != nullptr) {
+        vTaskDelay(1);
+    }
+    return ESP_OK;
+}
+
+// Dorme até present(); depois de uma falha acorda sozinha para reenviar
+void OLEDDisplay::flush_task(void* arg) {
+    OLEDDisplay* display = static_cast<OLEDDisplay*>(arg);
+    bool retry = false;
+
+    while (true) {
+        xSemaphoreTake(display->frame_ready_, retry ? pdMS_TO_TICKS(FLUSH_RETRY_MS) : portMAX_DELAY);
+        if (display->flush_stop_requested_) {
+            break;
+        }
+
+        esp_err_t result = display->transmit_front();
+        retry = (result != ESP_OK);
+        if (retry) {
+            ESP_LOGW(TAG, "Falha no envio ao display: %s", esp_err_to_name(result));
+        }
+    }
+
+    display->flush_task_ = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void OLEDDisplay::draw_text(uint8_t x, uint8_t y, const char* text, const DisplayFont& font) {
+    if (text == nullptr || y >= DISPLAY_HEIGHT) return;
+
+    const bool page_aligned = (y % 8) == 0;
+    for (uint16_t cursor = x; *text != '\0' && cursor < DISPLAY_WIDTH; text++, cursor += font.advance()) {
+        // Célula = glifo + espaçamento, cortada na borda direita
+        uint8_t width = (font.advance() < DISPLAY_WIDTH - cursor) ? font.advance() : (uint8_t)(DISPLAY_WIDTH - cursor);
+        const uint8_t* glyph = font.glyph(*text);
+        if (page_aligned) {
+            blit_glyph((uint8_t)cursor, y / 8, width, glyph, font);
+        } else {
+            plot_glyph((uint8_t)cursor, y, width, glyph, font);
+        }
+    }
+}
+
+// Cópia direta: as colunas da fonte já estão no formato da página. A faixa suja
+// cobre a célula inteira; o envio recorta o que já estiver igual no painel.
+void OLEDDisplay::blit_glyph(uint8_t x, uint8_t page, uint8_t width, const uint8_t* glyph,
+                             const DisplayFont& font) {
+    const uint8_t glyph_columns = (width < font.width) ? width : font.width;
+
+    for (uint8_t glyph_page = 0; glyph_page < font.pages && page + glyph_page < DISPLAY_PAGES; glyph_page++) {
+        uint8_t* destination = &framebuffer_[page + glyph_page][x];
+        if (glyph != nullptr) {
+            memcpy(destination, glyph + glyph_page * font.width, glyph_columns);
+        } else {
+            memset(destination, 0, glyph_columns);
+        }
+        memset(destination + glyph_columns, 0, width - glyph_columns);
+        mark_dirty(page + glyph_page, x, x + width - 1);
+    }
+}
+
+// Linha fora do alinhamento de página: cada pixel da célula passa por set_pixel()
+void OLEDDisplay::plot_glyph(uint8_t x, uint8_t y, uint8_t width, const uint8_t* glyph, const DisplayFont& font) {
+    const uint8_t cell_height = font.pages * 8;
+
+    for (uint8_t column = 0; column < width; column++) {
+        for (uint8_t row = 0; row < cell_height; row++) {
+            bool on = glyph != nullptr && column < font.width &&
+                      ((glyph[(row / 8) * font.width + column] >> (row % 8)) & 1) != 0;
+            set_pixel(x + column, y + row, on);
+        }
+    }
 }
 
 void OLEDDisplay::draw_horizontal_line(uint8_t x, uint8_t y, uint8_t length) {
-    if (!display_initialized_) return;
+    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT || length == 0) return;
 
-    // Implementação básica de linha horizontal
-    // Configurar posição
-    send_command(0xB0 + (y / 8)); // Page address
-    send_command(0x00 + (x & 0x0F)); // Lower column address
-    send_command(0x10 + ((x >> 4) & 0x0F)); // Higher column address
-    
-    // Desenhar linha (cada bit representa um pixel)
-    uint8_t line_data[128];
-    memset(line_data, 0xFF, length); // Todos os pixels ligados
-    send_data(line_data, length);
+    if (length > DISPLAY_WIDTH - x) {
+        length = DISPLAY_WIDTH - x;
+    }
+
+    for (uint8_t column = x; column < x + length; column++) {
+        set_pixel(column, y, true);
+    }
+}
+
+void OLEDDisplay::fill_page_columns(uint8_t page, uint8_t x, uint8_t width, uint8_t pattern) {
+    for (uint16_t column = x; column < (uint16_t)x + width && column < DISPLAY_WIDTH; column++) {
+        write_column_byte(page, (uint8_t)column, pattern);
+    }
+}
+
+void OLEDDisplay::draw_page_bitmap(uint8_t page, uint8_t x, const uint8_t* columns, uint8_t width) {
+    for (uint8_t i = 0; i < width && x + i < DISPLAY_WIDTH; i++) {
+        write_column_byte(page, x + i, columns[i]);
+    }
+}
+
+void OLEDDisplay::draw_frame_border() {
+    draw_horizontal_line(0, 0, DISPLAY_WIDTH);
+    draw_horizontal_line(0, DISPLAY_HEIGHT - 1, DISPLAY_WIDTH);
+}
+
+void OLEDDisplay::draw_centered_text(uint8_t y, const char* text, const DisplayFont& font) {
+    uint16_t width = font.measure(text);
+    draw_text((width < DISPLAY_WIDTH) ? (uint8_t)((DISPLAY_WIDTH - width) / 2) : 0, y, text, font);
+}
+
+// Quebra a mensagem nos espaços, uma linha por página a partir de first_page
+void OLEDDisplay::draw_wrapped_text(uint8_t first_page, uint8_t last_page, const char* text) {
+    const size_t max_chars = (DISPLAY_WIDTH + DisplayFont::SMALL.spacing) / DisplayFont::SMALL.advance();
+    char line[DISPLAY_WIDTH / 6 + 2];
+
+    for (uint8_t page = first_page; page <= last_page && *text != '\0'; page++) {
+        while (*text == ' ') {
+            text++;
+        }
+
+        size_t length = strlen(text);
+        if (length > max_chars) {
+            length = max_chars;
+            while (length > 0 && text[length] != ' ') {
+                length--;
+            }
+            if (length == 0) {
+                length = max_chars;
+            }
+        }
+
+        memcpy(line, text, length);
+        line[length] = '\0';
+        draw_centered_text(page * 8, line);
+        text += length;
+    }
 }
 
 void OLEDDisplay::display_welcome_screen() {
     if (!display_initialized_) return;
 
-    clear_display();
-    
-    // Tela de boas-vindas simples
-    // Usar comandos básicos para mostrar algo
     ESP_LOGI(TAG, "Exibindo tela de boas-vindas no OLED");
-    
-    // Desenhar borda
-    draw_horizontal_line(0, 0, 128);
-    draw_horizontal_line(0, 63, 128);
-    
-    // Mostrar via serial que o display está funcionando
-    ESP_LOGI("OLED", "=== MEDIDOR DE PRESSAO ===");
-    ESP_LOGI("OLED", "Sistema Inicializado");
-    ESP_LOGI("OLED", "Aguardando sensores...");
+
+    set_active_screen(Screen::OTHER);
+    clear_buffer();
+    draw_frame_border();
+    draw_centered_text(16, "Medidor de pressao");
+    draw_centered_text(32, "Sistema inicializado");
+    draw_centered_text(48, "Aguardando sensores");
+    present();
 }
 
 void OLEDDisplay::display_system_status(const char* status_message) {
-    if (!display_initialized_) return;
-    
+    if (!display_initialized_ || status_message == nullptr) return;
+
     ESP_LOGI("OLED", "Status: %s", status_message);
+
+    set_active_screen(Screen::OTHER);
+    clear_buffer();
+    draw_frame_border();
+    draw_wrapped_text(2, 5, status_message);
+    present();
 }
 
-void OLEDDisplay::display_sensor_readings(float temperature_celsius, float atmospheric_pressure_hpa, float tire_pressure_kpa) {
+void OLEDDisplay::enter_readings_screen() {
+    clear_buffer();
+    draw_frame_border();
+    readings_screen_.invalidate_all();
+    set_active_screen(Screen::READINGS);
+}
+
+void OLEDDisplay::display_sensor_readings(float temperature_celsius, float atmospheric_pressure_hpa,
+                                          float tire_pressure_kpa, StatusIconWidget::Icon status) {
     if (!display_initialized_) return;
-    
-    char buffer[64];
-    
-    // Limpar área de dados (mantendo bordas)
-    clear_display();
-    draw_horizontal_line(0, 0, 128);
-    draw_horizontal_line(0, 63, 128);
-    
-    // Mostrar dados via serial (enquanto não implementamos texto gráfico)
-    snprintf(buffer, sizeof(buffer), "Temp: %.1f C", temperature_celsius);
-    ESP_LOGI("OLED", "%s", buffer);
-    
-    snprintf(buffer, sizeof(buffer), "Atm: %.1f hPa", atmospheric_pressure_hpa);
-    ESP_LOGI("OLED", "%s", buffer);
-    
-    float tire_pressure_bar = tire_pressure_kpa / 100.0f;
-    snprintf(buffer, sizeof(buffer), "Pneu: %.2f bar", tire_pressure_bar);
-    ESP_LOGI("OLED", "%s", buffer);
-    
-    float tire_pressure_psi = tire_pressure_kpa * 0.145038f;
-    snprintf(buffer, sizeof(buffer), "Pneu: %.1f PSI", tire_pressure_psi);
-    ESP_LOGI("OLED", "%s", buffer);
+
+    if (active_screen_ != Screen::READINGS) {
+        enter_readings_screen();
+    }
+
+    temperature_field_.set_value(temperature_celsius);
+    atmospheric_field_.set_value(atmospheric_pressure_hpa);
+    tire_field_.set_value(tire_pressure_kpa / 100.0f);
+    tire_psi_field_.set_value(tire_pressure_kpa * 0.145038f);
+    tire_gauge_.set_value(tire_pressure_kpa);
+    status_icon_.set_icon(status);
+
+    // Nenhum widget mudou na resolução da tela: nada a entregar
+    if (readings_screen_.render(*this) > 0) {
+        present();
+    }
+}
+
+void OLEDDisplay::set_active_screen(Screen screen) {
+    active_screen_ = screen;
 }
 
 void OLEDDisplay::display_error_message(const char* error_message) {
-    if (!display_initialized_) return;
+    if (!display_initialized_ || error_message == nullptr) return;
     
     ESP_LOGE("OLED", "ERRO: %s", error_message);
-}
\ No newline at end of file
+
+    set_active_screen(Screen::OTHER);
+    clear_buffer();
+    draw_frame_border();
+    draw_centered_text(8, "ERRO");
+    draw_wrapped_text(3, 6, error_message);
+    present();
+}
+
+void OLEDDisplay::set_trend_column_period_ms(uint32_t period_ms) {
+    trend_column_period_us_ = (period_ms > 0) ? period_ms * 1000 : 1000;
+}
+
+uint32_t OLEDDisplay::get_trend_column_period_us() const {
+    return trend_column_period_us_;
+}
+
+void OLEDDisplay::enter_trend_screen() {
+    clear_buffer();
+    for (TrendColumn& column : trend_columns_) {
+        column = {TREND_NO_SAMPLE, TREND_NO_SAMPLE};
+    }
+    trend_head_ = DISPLAY_WIDTH - 1;
+    trend_pending_ = {TREND_NO_SAMPLE, TREND_NO_SAMPLE};
+    trend_floor_deci_kpa_ = TREND_NO_SAMPLE;
+    trend_last_column_us_ = 0;
+    trend_started_ = false;
+    trend_value_field_.set_unavailable();
+    trend_scale_label_.set_text("");
+    trend_screen_.invalidate_all();
+    set_active_screen(Screen::TREND);
+}
+
+// Períodos de coluna vencidos desde a última coluna posta no gráfico
+uint32_t OLEDDisplay::consume_trend_steps() {
+    const int64_t now_us = esp_timer_get_time();
+    int64_t steps = (now_us - trend_last_column_us_) / trend_column_period_us_;
+    if (steps <= 0) {
+        return 0;
+    }
+    // Muito tempo sem amostra: o gráfico inteiro já foi varrido, o período recomeça agora
+    if (steps > DISPLAY_WIDTH) {
+        trend_last_column_us_ = now_us;
+        return DISPLAY_WIDTH;
+    }
+    trend_last_column_us_ += steps * trend_column_period_us_;
+    return (uint32_t)steps;
+}
+
+// A coluna nova entra no cursor e a seguinte vira a lacuna; só as duas vão para o
+// buffer, a não ser que a escala mude
+void OLEDDisplay::push_trend_column(const TrendColumn& column) {
+    trend_head_ = (uint8_t)((trend_head_ + 1) % DISPLAY_WIDTH);
+    trend_columns_[trend_head_] = column;
+
+    if (column.min_deci_kpa != TREND_NO_SAMPLE &&
+        (trend_floor_deci_kpa_ == TREND_NO_SAMPLE || column.min_deci_kpa < trend_floor_deci_kpa_ ||
+         column.max_deci_kpa > trend_floor_deci_kpa_ + TREND_SPAN_DECI_KPA)) {
+        recenter_trend((int16_t)((column.min_deci_kpa + column.max_deci_kpa) / 2));
+    }
+
+    draw_trend_column(trend_head_, column);
+    // Na última coluna não há lacuna: a mais antiga fica na borda oposta, e apagar a
+    // coluna 0 juntaria as duas bordas numa faixa de 128 colunas
+    if (trend_head_ + 1 < DISPLAY_WIDTH) {
+        trend_columns_[trend_head_ + 1] = {TREND_NO_SAMPLE, TREND_NO_SAMPLE};
+        draw_trend_column(trend_head_ + 1, trend_columns_[trend_head_ + 1]);
+    }
+}
+
+// Nova faixa centrada no valor, com o piso em kPa inteiro; o gráfico todo muda de escala
+void OLEDDisplay::recenter_trend(int16_t deci_kpa) {
+    int32_t floor_deci_kpa = deci_kpa - TREND_SPAN_DECI_KPA / 2;
+    floor_deci_kpa -= ((floor_deci_kpa % 10) + 10) % 10;
+    trend_floor_deci_kpa_ = (int16_t)floor_deci_kpa;
+
+    char scale[LabelWidget::MAX_TEXT + 1];
+    snprintf(scale, sizeof(scale), "%d-%d kPa", (int)(floor_deci_kpa / 10),
+             (int)((floor_deci_kpa + TREND_SPAN_DECI_KPA) / 10));
+    trend_scale_label_.set_text(scale);
+}
+
+// Linha do gráfico (0 = topo) para um valor, limitada à faixa
+uint8_t OLEDDisplay::trend_row(int16_t deci_kpa) const {
+    int32_t offset = deci_kpa - trend_floor_deci_kpa_;
+    offset = (offset < 0) ? 0 : ((offset > TREND_SPAN_DECI_KPA) ? TREND_SPAN_DECI_KPA : offset);
+    return (uint8_t)(TREND_HEIGHT - 1 - offset * (TREND_HEIGHT - 1) / TREND_SPAN_DECI_KPA);
+}
+
+// Traço vertical do mínimo ao máximo da coluna; coluna sem amostra fica apagada
+void OLEDDisplay::draw_trend_column(uint8_t x, const TrendColumn& column) {
+    uint8_t bytes[TREND_LAST_PAGE - TREND_FIRST_PAGE + 1] = {};
+
+    if (column.min_deci_kpa != TREND_NO_SAMPLE) {
+        for (uint8_t row = trend_row(column.max_deci_kpa); row <= trend_row(column.min_deci_kpa); row++) {
+            bytes[row / 8] |= (uint8_t)(1u << (row % 8));
+        }
+    }
+    for (uint8_t page = TREND_FIRST_PAGE; page <= TREND_LAST_PAGE; page++) {
+        write_column_byte(page, x, bytes[page - TREND_FIRST_PAGE]);
+    }
+}
+
+// Gráfico inteiro no buffer, só quando a escala muda; cada coluna fica onde foi posta
+void OLEDDisplay::draw_trend_graph() {
+    for (uint8_t x = 0; x < DISPLAY_WIDTH; x++) {
+        draw_trend_column(x, trend_columns_[x]);
+    }
+}
+
+void OLEDDisplay::display_trend(float tire_pressure_kpa) {
+    if (!display_initialized_) return;
+
+    if (active_screen_ != Screen::TREND) {
+        enter_trend_screen();
+    }
+
+    if (isnan(tire_pressure_kpa)) {
+        trend_value_field_.set_unavailable();
+    } else {
+        float deci_kpa = tire_pressure_kpa * 10.0f;
+        deci_kpa = (deci_kpa < -32000.0f) ? -32000.0f : ((deci_kpa > 32000.0f) ? 32000.0f : deci_kpa);
+        int16_t sample = (int16_t)lroundf(deci_kpa);
+        if (trend_pending_.min_deci_kpa == TREND_NO_SAMPLE || sample < trend_pending_.min_deci_kpa) {
+            trend_pending_.min_deci_kpa = sample;
+        }
+        if (trend_pending_.max_deci_kpa == TREND_NO_SAMPLE || sample > trend_pending_.max_deci_kpa) {
+            trend_pending_.max_deci_kpa = sample;
+        }
+        trend_value_field_.set_value(tire_pressure_kpa);
+    }
+
+    // Uma coluna por período; a primeira amostra já aparece e abre o primeiro período
+    uint32_t steps = 0;
+    if (trend_started_) {
+        steps = consume_trend_steps();
+    } else if (trend_pending_.min_deci_kpa != TREND_NO_SAMPLE) {
+        steps = 1;
+        trend_last_column_us_ = esp_timer_get_time();
+        trend_started_ = true;
+    }
+
+    bool graph_changed = false;
+    if (steps > 0) {
+        // Mais de um período desde a última amostra: a coluna se repete
+        const int16_t previous_floor = trend_floor_deci_kpa_;
+        for (uint32_t i = 0; i < steps; i++) {
+            push_trend_column(trend_pending_);
+        }
+        trend_pending_ = {TREND_NO_SAMPLE, TREND_NO_SAMPLE};
+        if (trend_floor_deci_kpa_ != previous_floor) {
+            draw_trend_graph();
+        }
+        graph_changed = true;
+    }
+
+    if (trend_screen_.render(*this) > 0 || graph_changed) {
+        present();
+    }
+}
@@ -0,0 +1,49 @@
+#include "text_render_benchmark.hpp"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <string.h>
+
+static const char *TAG = "TextBenchmark";
+
+TextRenderBenchmark::TextRenderBenchmark(OLEDDisplay* display) : display_(display) {}
+
+TextRenderBenchmark::Result TextRenderBenchmark::run(const char* name, const char* text, const DisplayFont& font,
+                                                     uint8_t y, uint32_t iterations) {
+    Result result = {};
+    result.name = name;
+    result.glyphs = (uint32_t)strlen(text) * iterations;
+
+    int64_t start_us = esp_timer_get_time();
+    for (uint32_t i = 0; i < iterations; i++) {
+        display_->draw_text(0, y, text, font);
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start_us;
+
+    result.ns_per_glyph = (result.glyphs > 0) ? (float)elapsed_us * 1000.0f / (float)result.glyphs : 0;
+    return result;
+}
+
+void TextRenderBenchmark::log_result(const Result& result) const {
+    ESP_LOGI(TAG, "%-24s %8.1f ns/glifo (%lu glifos)", result.name, result.ns_per_glyph,
+             (unsigned long)result.glyphs);
+}
+
+void TextRenderBenchmark::run_standard_suite() {
+    static const char SMALL_TEXT[] = "ATM: 1013.2 HPA";
+    static const char LARGE_TEXT[] = "2.20";
+
+    Result small_blit = run("5x7 alinhada (memcpy)", SMALL_TEXT, DisplayFont::SMALL, 8);
+    Result small_plot = run("5x7 deslocada (pixel)", SMALL_TEXT, DisplayFont::SMALL, 9);
+    Result large_blit = run("10x16 alinhada (memcpy)", LARGE_TEXT, DisplayFont::LARGE_NUMERIC, 24);
+    Result large_plot = run("10x16 deslocada (pixel)", LARGE_TEXT, DisplayFont::LARGE_NUMERIC, 25);
+    display_->clear_display();
+
+    log_result(small_blit);
+    log_result(small_plot);
+    log_result(large_blit);
+    log_result(large_plot);
+    if (small_blit.ns_per_glyph > 0 && large_blit.ns_per_glyph > 0) {
+        ESP_LOGI(TAG, "Ganho do memcpy: %.1fx na 5x7, %.1fx na 10x16",
+                 small_plot.ns_per_glyph / small_blit.ns_per_glyph, large_plot.ns_per_glyph / large_blit.ns_per_glyph);
+    }
+}
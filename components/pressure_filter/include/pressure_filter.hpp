@@ -0,0 +1,100 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Estágio de filtro sobre amostras brutas inteiras (contagens do ADC). Cada chamada
+// processa um bloco no próprio buffer e retorna quantas amostras saíram; estágios
+// com decimação devolvem menos amostras do que receberam.
+class FilterStage {
+public:
+    virtual ~FilterStage() {}
+
+    virtual size_t process(int32_t* samples, size_t count) = 0;
+    virtual void reset() = 0;
+    virtual const char* get_name() const = 0;
+};
+
+// Média móvel de 2^window_log2 amostras com soma corrente, emitindo uma saída a
+// cada `decimation` entradas
+class MovingAverageFilter : public FilterStage {
+public:
+    static constexpr uint8_t MAX_WINDOW_LOG2 = 5;
+
+    MovingAverageFilter(uint8_t window_log2, uint8_t decimation);
+
+    size_t process(int32_t* samples, size_t count) override;
+    void reset() override;
+    const char* get_name() const override { return "media movel"; }
+
+private:
+    uint8_t window_log2_;
+    uint8_t decimation_;
+    int32_t history_[1 << MAX_WINDOW_LOG2];
+    int32_t running_sum_;
+    uint32_t filled_;
+    uint32_t next_;
+    uint8_t decimation_count_;
+};
+
+// Mediana das últimas window_size amostras (ímpar, até 7): remove picos isolados
+// sem arrastar a média
+class MedianFilter : public FilterStage {
+public:
+    static constexpr uint8_t MAX_WINDOW_SIZE = 7;
+
+    explicit MedianFilter(uint8_t window_size);
+
+    size_t process(int32_t* samples, size_t count) override;
+    void reset() override;
+    const char* get_name() const override { return "mediana"; }
+
+private:
+    uint8_t window_size_;
+    int32_t history_[MAX_WINDOW_SIZE];
+    uint8_t filled_;
+    uint8_t next_;
+};
+
+// Kalman 1-D (modelo constante + ruído de processo) em ponto fixo: estado em Q4
+// contagens, variâncias em contagens², ganho em Q16
+class KalmanFilter : public FilterStage {
+public:
+    // process_noise: variância de deriva por amostra; measurement_noise: variância do ruído
+    KalmanFilter(uint32_t process_noise, uint32_t measurement_noise);
+
+    size_t process(int32_t* samples, size_t count) override;
+    void reset() override;
+    const char* get_name() const override { return "kalman"; }
+
+    void set_noise(uint32_t process_noise, uint32_t measurement_noise);
+    uint32_t get_gain_q16() const { return gain_q16_; }
+
+private:
+    static constexpr int STATE_FRACTION_BITS = 4;
+    static constexpr int GAIN_FRACTION_BITS = 16;
+
+    uint32_t process_noise_;
+    uint32_t measurement_noise_;
+    int32_t estimate_q4_;
+    uint32_t error_variance_;
+    uint32_t gain_q16_;
+    bool initialized_;
+};
+
+// Cadeia de estágios aplicada em sequência sobre o mesmo bloco. Os estágios são
+// do chamador; a pipeline só guarda os ponteiros.
+class FilterPipeline {
+public:
+    static constexpr size_t MAX_STAGES = 4;
+
+    FilterPipeline();
+
+    bool add_stage(FilterStage* stage);
+    size_t process(int32_t* samples, size_t count);
+    void reset();
+    size_t get_stage_count() const { return stage_count_; }
+
+private:
+    FilterStage* stages_[MAX_STAGES];
+    size_t stage_count_;
+};
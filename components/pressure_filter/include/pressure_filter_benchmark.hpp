@@ -0,0 +1,43 @@
+#pragma once
+#include "pressure_filter.hpp"
+
+// Mede custo por amostra e qualidade de uma pipeline sobre um sinal sintético:
+// patamar com ruído uniforme e picos esparsos, depois um degrau. Roda igual no
+// alvo e no host (tempo por esp_timer), para escolher o filtro mais barato que
+// atende o ruído desejado.
+class FilterBenchmark {
+public:
+    struct Result {
+        const char* name;
+        size_t input_samples;
+        size_t output_samples;
+        float ns_per_sample;
+        // RMS do erro no patamar, depois do aquecimento
+        float noise_rms_counts;
+        // Saídas após o degrau até chegar a 90% dele
+        uint32_t settling_samples;
+    };
+
+    static constexpr size_t BLOCK_SIZE = 64;
+    static constexpr size_t DEFAULT_SAMPLE_COUNT = 4096;
+
+    FilterBenchmark(int32_t baseline_counts, uint32_t noise_amplitude_counts, int32_t step_counts);
+
+    Result run(FilterPipeline& pipeline, const char* name, size_t sample_count = DEFAULT_SAMPLE_COUNT);
+    void log_result(const Result& result) const;
+    // Configurações candidatas (média, mediana, kalman e combinações), com o ruído
+    // do Kalman derivado da amplitude do sinal
+    void run_standard_suite();
+
+private:
+    int32_t baseline_counts_;
+    uint32_t noise_amplitude_counts_;
+    int32_t step_counts_;
+    uint32_t noise_state_;
+
+    static constexpr uint32_t SPIKE_INTERVAL = 97;
+    static constexpr uint32_t SPIKE_SCALE = 20;
+    static constexpr size_t WARMUP_SAMPLES = 64;
+
+    void fill_block(int32_t* block, size_t first_index, size_t count, size_t step_index);
+};
@@ -0,0 +1,160 @@
+#include "pressure_filter.hpp"
+
+MovingAverageFilter::MovingAverageFilter(uint8_t window_log2, uint8_t decimation)
+    : window_log2_((window_log2 > MAX_WINDOW_LOG2) ? MAX_WINDOW_LOG2 : window_log2),
+      decimation_((decimation > 0) ? decimation : 1) {
+    reset();
+}
+
+void MovingAverageFilter::reset() {
+    for (size_t i = 0; i < sizeof(history_) / sizeof(history_[0]); i++) {
+        history_[i] = 0;
+    }
+    running_sum_ = 0;
+    filled_ = 0;
+    next_ = 0;
+    decimation_count_ = 0;
+}
+
+size_t MovingAverageFilter::process(int32_t* samples, size_t count) {
+    const uint32_t window_size = 1u << window_log2_;
+    size_t output_count = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        // Soma corrente: entra a amostra nova, sai a que completou a janela.
+        // 24 bits x 32 amostras cabem em 32 bits.
+        running_sum_ += samples[i] - history_[next_];
+        history_[next_] = samples[i];
+        next_ = (next_ + 1) & (window_size - 1);
+        if (filled_ < window_size) {
+            filled_++;
+        }
+
+        if (++decimation_count_ < decimation_) {
+            continue;
+        }
+        decimation_count_ = 0;
+
+        // Janela cheia: divisão por deslocamento; no aquecimento divide pelo que há
+        if (filled_ == window_size) {
+            samples[output_count++] = (running_sum_ + (int32_t)(window_size >> 1)) >> window_log2_;
+        } else {
+            samples[output_count++] = running_sum_ / (int32_t)filled_;
+        }
+    }
+
+    return output_count;
+}
+
+MedianFilter::MedianFilter(uint8_t window_size) {
+    if (window_size > MAX_WINDOW_SIZE) {
+        window_size = MAX_WINDOW_SIZE;
+    }
+    // Janela ímpar para a mediana ser uma das amostras
+    window_size_ = (window_size | 1);
+    if (window_size_ > MAX_WINDOW_SIZE) {
+        window_size_ = MAX_WINDOW_SIZE;
+    }
+    reset();
+}
+
+void MedianFilter::reset() {
+    filled_ = 0;
+    next_ = 0;
+}
+
+size_t MedianFilter::process(int32_t* samples, size_t count) {
+    int32_t sorted[MAX_WINDOW_SIZE];
+
+    for (size_t i = 0; i < count; i++) {
+        history_[next_] = samples[i];
+        next_ = (next_ + 1 == window_size_) ? 0 : next_ + 1;
+        if (filled_ < window_size_) {
+            filled_++;
+        }
+
+        // Inserção sobre no máximo 7 valores: mais barato que qualquer estrutura
+        for (uint8_t j = 0; j < filled_; j++) {
+            int32_t value = history_[j];
+            int k = j - 1;
+            while (k >= 0 && sorted[k] > value) {
+                sorted[k + 1] = sorted[k];
+                k--;
+            }
+            sorted[k + 1] = value;
+        }
+        samples[i] = sorted[filled_ >> 1];
+    }
+
+    return count;
+}
+
+KalmanFilter::KalmanFilter(uint32_t process_noise, uint32_t measurement_noise)
+    : process_noise_(process_noise), measurement_noise_((measurement_noise > 0) ? measurement_noise : 1) {
+    reset();
+}
+
+void KalmanFilter::reset() {
+    estimate_q4_ = 0;
+    error_variance_ = 0;
+    gain_q16_ = 0;
+    initialized_ = false;
+}
+
+void KalmanFilter::set_noise(uint32_t process_noise, uint32_t measurement_noise) {
+    process_noise_ = process_noise;
+    measurement_noise_ = (measurement_noise > 0) ? measurement_noise : 1;
+}
+
+size_t KalmanFilter::process(int32_t* samples, size_t count) {
+    size_t i = 0;
+
+    // Primeira medida vira o estado inicial com a incerteza do sensor
+    if (!initialized_ && count > 0) {
+        estimate_q4_ = samples[0] << STATE_FRACTION_BITS;
+        error_variance_ = measurement_noise_;
+        initialized_ = true;
+        i = 1;
+    }
+
+    for (; i < count; i++) {
+        // Predição: o estado fica, a incerteza cresce pela deriva
+        uint32_t predicted_variance = error_variance_ + process_noise_;
+
+        // Atualização: K = P / (P + R)
+        uint32_t gain_q16 = (uint32_t)(((uint64_t)predicted_variance << GAIN_FRACTION_BITS) /
+                                       ((uint64_t)predicted_variance + measurement_noise_));
+        int32_t innovation_q4 = (samples[i] << STATE_FRACTION_BITS) - estimate_q4_;
+        estimate_q4_ += (int32_t)(((int64_t)innovation_q4 * gain_q16) >> GAIN_FRACTION_BITS);
+        error_variance_ = (uint32_t)(((uint64_t)predicted_variance * ((1u << GAIN_FRACTION_BITS) - gain_q16)) >>
+                                     GAIN_FRACTION_BITS);
+        gain_q16_ = gain_q16;
+
+        samples[i] = (estimate_q4_ + (1 << (STATE_FRACTION_BITS - 1))) >> STATE_FRACTION_BITS;
+    }
+
+    return count;
+}
+
+FilterPipeline::FilterPipeline() : stages_{}, stage_count_(0) {}
+
+bool FilterPipeline::add_stage(FilterStage* stage) {
+    if (stage == nullptr || stage_count_ >= MAX_STAGES) {
+        return false;
+    }
+    stages_[stage_count_++] = stage;
+    return true;
+}
+
+size_t FilterPipeline::process(int32_t* samples, size_t count) {
+    for (size_t i = 0; i < stage_count_ && count > 0; i++) {
+        count = stages_[i]->process(samples, count);
+    }
+    return count;
+}
+
+void FilterPipeline::reset() {
+    for (size_t i = 0; i < stage_count_; i++) {
+        stages_[i]->reset();
+    }
+}
@@ -0,0 +1,144 @@
+#include "pressure_filter_benchmark.hpp"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <math.h>
+
+static const char *TAG = "FilterBenchmark";
+
+FilterBenchmark::FilterBenchmark(int32_t baseline_counts, uint32_t noise_amplitude_counts, int32_t step_counts)
+    : baseline_counts_(baseline_counts), noise_amplitude_counts_(noise_amplitude_counts),
+      step_counts_(step_counts), noise_state_(0xACE1u) {}
+
+void FilterBenchmark::fill_block(int32_t* block, size_t first_index, size_t count, size_t step_index) {
+    for (size_t i = 0; i < count; i++) {
+        size_t index = first_index + i;
+        int32_t value = baseline_counts_ + ((index >= step_index) ? step_counts_ : 0);
+
+        if (noise_amplitude_counts_ > 0) {
+            noise_state_ = noise_state_ * 1664525u + 1013904223u;
+            value += (int32_t)((noise_state_ >> 8) % (2 * noise_amplitude_counts_ + 1)) -
+                     (int32_t)noise_amplitude_counts_;
+            if (index % SPIKE_INTERVAL == SPIKE_INTERVAL - 1) {
+                value += (int32_t)(noise_amplitude_counts_ * SPIKE_SCALE);
+            }
+        }
+        block[i] = value;
+    }
+}
+
+FilterBenchmark::Result FilterBenchmark::run(FilterPipeline& pipeline, const char* name, size_t sample_count) {
+    int32_t block[BLOCK_SIZE];
+    const size_t step_index = sample_count / 2;
+    const int32_t settled_threshold = step_counts_ - step_counts_ / 10;
+
+    Result result = {};
+    result.name = name;
+    result.input_samples = sample_count;
+
+    double error_sum_sq = 0;
+    size_t error_count = 0;
+    size_t outputs_after_step = 0;
+    bool settled = false;
+    int64_t elapsed_us = 0;
+
+    pipeline.reset();
+    noise_state_ = 0xACE1u;
+
+    for (size_t first = 0; first < sample_count; first += BLOCK_SIZE) {
+        size_t count = (sample_count - first < BLOCK_SIZE) ? sample_count - first : BLOCK_SIZE;
+        fill_block(block, first, count, step_index);
+
+        // Só o processamento entra na medida, não a geração do sinal
+        int64_t start_us = esp_timer_get_time();
+        size_t output_count = pipeline.process(block, count);
+        elapsed_us += esp_timer_get_time() - start_us;
+
+        // Cada saída é atribuída à entrada mais recente do bloco proporcional à decimação
+        for (size_t i = 0; i < output_count; i++) {
+            size_t input_index = first + ((i + 1) * count) / output_count - 1;
+            if (input_index < step_index) {
+                if (input_index >= WARMUP_SAMPLES) {
+                    double error = (double)(block[i] - baseline_counts_);
+                    error_sum_sq += error * error;
+                    error_count++;
+                }
+            } else {
+                if (!settled && block[i] - baseline_counts_ >= settled_threshold) {
+                    settled = true;
+                    result.settling_samples = (uint32_t)outputs_after_step;
+                }
+                outputs_after_step++;
+            }
+        }
+        result.output_samples += output_count;
+    }
+
+    result.ns_per_sample = (float)elapsed_us * 1000.0f / (float)sample_count;
+    result.noise_rms_counts = (error_count > 0) ? (float)sqrt(error_sum_sq / error_count) : 0;
+    if (!settled) {
+        result.settling_samples = (uint32_t)outputs_after_step;
+    }
+    return result;
+}
+
+void FilterBenchmark::log_result(const Result& result) const {
+    ESP_LOGI(TAG, "%-24s %7.1f ns/amostra, ruído %7.1f contagens RMS, %4u saídas até 90%% do degrau, %u/%u saídas",
+             result.name, result.ns_per_sample, result.noise_rms_counts, (unsigned)result.settling_samples,
+             (unsigned)result.output_samples, (unsigned)result.input_samples);
+}
+
+void FilterBenchmark::run_standard_suite() {
+    // Variância do ruído uniforme: A²/3
+    uint32_t measurement_noise = (noise_amplitude_counts_ * noise_amplitude_counts_) / 3 + 1;
+    uint32_t slow_process_noise = measurement_noise / 64 + 1;
+    uint32_t fast_process_noise = measurement_noise / 8 + 1;
+
+    ESP_LOGI(TAG, "Sinal: patamar %ld, ruído ±%lu, picos de %lux a cada %lu, degrau de %ld contagens",
+             (long)baseline_counts_, (unsigned long)noise_amplitude_counts_, (unsigned long)SPIKE_SCALE,
+             (unsigned long)SPIKE_INTERVAL, (long)step_counts_);
+
+    {
+        FilterPipeline pipeline;
+        log_result(run(pipeline, "sem filtro"));
+    }
+    {
+        MovingAverageFilter average(3, 1);
+        FilterPipeline pipeline;
+        pipeline.add_stage(&average);
+        log_result(run(pipeline, "media 8"));
+    }
+    {
+        MovingAverageFilter average(4, 4);
+        FilterPipeline pipeline;
+        pipeline.add_stage(&average);
+        log_result(run(pipeline, "media 16 / 4"));
+    }
+    {
+        MedianFilter median(5);
+        FilterPipeline pipeline;
+        pipeline.add_stage(&median);
+        log_result(run(pipeline, "mediana 5"));
+    }
+    {
+        KalmanFilter kalman(slow_process_noise, measurement_noise);
+        FilterPipeline pipeline;
+        pipeline.add_stage(&kalman);
+        log_result(run(pipeline, "kalman lento"));
+    }
+    {
+        MedianFilter median(3);
+        KalmanFilter kalman(fast_process_noise, measurement_noise);
+        FilterPipeline pipeline;
+        pipeline.add_stage(&median);
+        pipeline.add_stage(&kalman);
+        log_result(run(pipeline, "mediana 3 + kalman"));
+    }
+    {
+        MedianFilter median(3);
+        MovingAverageFilter average(3, 2);
+        FilterPipeline pipeline;
+        pipeline.add_stage(&median);
+        pipeline.add_stage(&average);
+        log_result(run(pipeline, "mediana 3 + media 8 / 2"));
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+#include "bmp280_driver.hpp"
+#include "smp3011_driver.hpp"
+
+// Leitura coerente dos dois sensores: start() dispara as duas conversões em
+// sequência (a mais longa primeiro) para que corram em paralelo, e poll() busca
+// cada resultado quando fica pronto. O registro final junta valores brutos,
+// compensados e a pressão manométrica do mesmo instante, com a defasagem entre
+// os dois sensores. No modo normal do BMP280 o instante atmosférico é só uma
+// estimativa (até meio ciclo de erro), e a incerteza acompanha a defasagem.
+// Com a captura contínua do SMP3011 ativa a task de captura é dona do sensor: o
+// pneu chega por provide_tire_sample() e vale a amostra mais próxima da
+// leitura atmosférica.
+class SnapshotEngine {
+public:
+    struct Snapshot {
+        uint32_t sequence;
+        // Ponto médio entre os instantes dos dois sensores
+        int64_t timestamp_us;
+        // Instante do pneu menos instante da atmosfera, ±skew_uncertainty_us
+        int64_t skew_us;
+        uint32_t skew_uncertainty_us;
+        int32_t raw_temperature;
+        int32_t raw_atmospheric;
+        uint32_t raw_tire;
+        float temperature_celsius;
+        float atmospheric_hectopascal;
+        float tire_absolute_kilopascal;
+        float tire_gauge_kilopascal;
+        esp_err_t atmospheric_result;
+        esp_err_t tire_result;
+        // Do disparo ao último resultado
+        uint32_t acquisition_us;
+    };
+
+    struct Stats {
+        uint32_t snapshots;
+        uint32_t partial_snapshots;
+        int64_t max_skew_us;
+        int64_t mean_skew_us;
+        // Pior caso de |skew_us| + skew_uncertainty_us
+        int64_t max_skew_bound_us;
+        uint32_t max_acquisition_us;
+        uint32_t mean_acquisition_us;
+    };
+
+    SnapshotEngine(BMP280Driver* bmp280, SMP3011Driver* smp3011);
+
+    esp_err_t start();
+    // complete=true quando os dois sensores terminaram (com ou sem erro)
+    esp_err_t poll(bool* complete);
+    void provide_tire_sample(const SMP3011Driver::Sample& sample);
+    // Versão bloqueante: start() e espera pelo registro completo
+    esp_err_t acquire(Snapshot* snapshot);
+
+    bool is_active() const { return active_; }
+    uint32_t get_ready_time_hint_us() const;
+    const Snapshot& get_snapshot() const { return snapshot_; }
+    Stats get_stats() const;
+    void reset_stats();
+
+    static float compute_gauge_kilopascal(float absolute_kilopascal, float atmospheric_hectopascal) {
+        return absolute_kilopascal - atmospheric_hectopascal / 10.0f;
+    }
+
+private:
+    BMP280Driver* bmp280_;
+    SMP3011Driver* smp3011_;
+
+    // Registro em montagem e último completo
+    Snapshot pending_;
+    Snapshot snapshot_;
+    uint32_t sequence_;
+    bool active_;
+    bool atmospheric_done_;
+    bool tire_done_;
+    bool tire_external_;
+    bool tire_sample_valid_;
+    int64_t start_us_;
+    int64_t atmospheric_timestamp_us_;
+    uint32_t atmospheric_uncertainty_us_;
+    // Fim previsto da conversão do pneu disparada por start()
+    int64_t tire_ready_us_;
+    SMP3011Driver::Sample tire_sample_;
+
+    uint32_t snapshots_;
+    uint32_t partial_snapshots_;
+    int64_t max_skew_us_;
+    int64_t max_skew_bound_us_;
+    int64_t total_skew_us_;
+    uint32_t max_acquisition_us_;
+    uint64_t total_acquisition_us_;
+
+    void poll_atmospheric();
+    void poll_tire();
+    void finish();
+};
@@ -0,0 +1,290 @@
+#include "snapshot_engine.hpp"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "SnapshotEngine";
+
+static int64_t absolute_skew(int64_t skew_us) {
+    return (skew_us < 0) ? -skew_us : skew_us;
+}
+
+SnapshotEngine::SnapshotEngine(BMP280Driver* bmp280, SMP3011Driver* smp3011)
+    : bmp280_(bmp280), smp3011_(smp3011), pending_{}, snapshot_{}, sequence_(0), active_(false),
+      atmospheric_done_(false), tire_done_(false), tire_external_(false), tire_sample_valid_(false),
+      start_us_(0), atmospheric_timestamp_us_(0), atmospheric_uncertainty_us_(0), tire_ready_us_(0), tire_sample_{},
+      snapshots_(0), partial_snapshots_(0), max_skew_us_(0), max_skew_bound_us_(0), total_skew_us_(0),
+      max_acquisition_us_(0), total_acquisition_us_(0) {}
+
+esp_err_t SnapshotEngine::start() {
+    if (active_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    pending_ = {};
+    pending_.atmospheric_result = ESP_ERR_NOT_FINISHED;
+    pending_.tire_result = ESP_ERR_NOT_FINISHED;
+    atmospheric_done_ = false;
+    tire_done_ = false;
+    tire_sample_valid_ = false;
+    tire_external_ = smp3011_->is_capture_running();
+    start_us_ = esp_timer_get_time();
+
+    // A conversão mais longa sai primeiro; a outra corre inteira dentro dela.
+    // No modo normal o BMP280 não tem conversão a disparar.
+    bool atmospheric_forced = bmp280_->get_measurement_config().mode == BMP280Driver::PowerMode::FORCED;
+    uint32_t atmospheric_us = atmospheric_forced ? bmp280_->get_measurement_time_us() : 0;
+    uint32_t tire_us = tire_external_ ? 0 : smp3011_->get_conversion_time_us();
+
+    esp_err_t atmospheric_result = ESP_OK;
+    esp_err_t tire_result = ESP_OK;
+    if (tire_us > atmospheric_us) {
+        tire_result = smp3011_->start_measurement();
+        tire_ready_us_ = esp_timer_get_time() + tire_us;
+        atmospheric_result = bmp280_->start_measurement();
+    } else {
+        atmospheric_result = bmp280_->start_measurement();
+        if (!tire_external_) {
+            tire_result = smp3011_->start_measurement();
+            tire_ready_us_ = esp_timer_get_time() + tire_us;
+        }
+    }
+
+    if (atmospheric_result != ESP_OK) {
+        ESP_LOGW(TAG, "Falha ao disparar BMP280: %s", esp_err_to_name(atmospheric_result));
+        pending_.atmospheric_result = atmospheric_result;
+        atmospheric_done_ = true;
+    }
+    if (tire_result != ESP_OK) {
+        ESP_LOGW(TAG, "Falha ao disparar SMP3011: %s", esp_err_to_name(tire_result));
+        pending_.tire_result = tire_result;
+        tire_done_ = true;
+    }
+
+    if (atmospheric_done_ && tire_done_) {
+        return atmospheric_result;
+    }
+
+    active_ = true;
+    return ESP_OK;
+}
+
+esp_err_t SnapshotEngine::poll(bool* complete) {
+    *complete = false;
+    if (!active_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (!tire_done_ && !tire_external_) {
+        poll_tire();
+    }
+    if (!atmospheric_done_) {
+        poll_atmospheric();
+    }
+
+    // Captura contínua: o pneu fica com a amostra mais próxima entregue até aqui
+    if (tire_external_ && atmospheric_done_ && !tire_done_) {
+        pending_.tire_result = tire_sample_valid_ ? ESP_OK : ESP_ERR_NOT_FOUND;
+        tire_done_ = true;
+    }
+
+    if (atmospheric_done_ && tire_done_) {
+        finish();
+        *complete = true;
+    }
+    return ESP_OK;
+}
+
+void SnapshotEngine::poll_atmospheric() {
+    // Modo normal: os registradores se renovam sozinhos, então a leitura espera o
+    // fim da conversão do pneu para cair no mesmo instante
+    bool atmospheric_forced = bmp280_->get_measurement_config().mode == BMP280Driver::PowerMode::FORCED;
+    if (!atmospheric_forced && !tire_external_ && !tire_done_) {
+        return;
+    }
+
+    BMP280Driver::Reading reading;
+    esp_err_t result = bmp280_->fetch_reading(&reading);
+    if (result == ESP_ERR_NOT_FINISHED) {
+        return;
+    }
+
+    atmospheric_done_ = true;
+    pending_.atmospheric_result = result;
+    if (result != ESP_OK) {
+        ESP_LOGW(TAG, "Falha na leitura do BMP280: %s", esp_err_to_name(result));
+        return;
+    }
+
+    pending_.raw_temperature = reading.raw_temperature;
+    pending_.raw_atmospheric = reading.raw_pressure;
+    pending_.temperature_celsius = reading.temperature_celsius;
+    pending_.atmospheric_hectopascal = reading.pressure_hectopascal;
+    atmospheric_timestamp_us_ = reading.timestamp_us;
+    atmospheric_uncertainty_us_ = reading.timestamp_uncertainty_us;
+}
+
+void SnapshotEngine::poll_tire() {
+    SMP3011Driver::Sample sample;
+    esp_err_t result = smp3011_->fetch_sample(&sample);
+    if (result == ESP_ERR_NOT_FINISHED) {
+        return;
+    }
+
+    tire_done_ = true;
+    pending_.tire_result = result;
+    if (result != ESP_OK) {
+        ESP_LOGW(TAG, "Falha na leitura do SMP3011: %s", esp_err_to_name(result));
+        return;
+    }
+
+    // O SMP3011 guarda o resultado: o instante do dado é o fim da conversão, não a leitura
+    tire_sample_ = sample;
+    if (tire_ready_us_ < sample.timestamp_us) {
+        tire_sample_.timestamp_us = tire_ready_us_;
+    }
+    tire_sample_valid_ = true;
+}
+
+// Antes da leitura atmosférica a amostra mais nova é a mais próxima; depois,
+// fica a de menor distância até ela
+void SnapshotEngine::provide_tire_sample(const SMP3011Driver::Sample& sample) {
+    if (!active_ || !tire_external_ || tire_done_) {
+        return;
+    }
+
+    bool replace = !tire_sample_valid_;
+    if (!replace && atmospheric_done_ && pending_.atmospheric_result == ESP_OK) {
+        replace = absolute_skew(sample.timestamp_us - atmospheric_timestamp_us_) <
+                  absolute_skew(tire_sample_.timestamp_us - atmospheric_timestamp_us_);
+    } else if (!replace) {
+        replace = sample.timestamp_us > tire_sample_.timestamp_us;
+    }
+
+    if (replace) {
+        tire_sample_ = sample;
+        tire_sample_valid_ = true;
+    }
+}
+
+void SnapshotEngine::finish() {
+    bool atmospheric_valid = pending_.atmospheric_result == ESP_OK;
+    bool tire_valid = pending_.tire_result == ESP_OK && tire_sample_valid_;
+
+    if (tire_valid) {
+        pending_.raw_tire = tire_sample_.raw_pressure;
+        pending_.tire_absolute_kilopascal = tire_sample_.pressure_kilopascal;
+    }
+
+    int64_t now_us = esp_timer_get_time();
+    if (atmospheric_valid && tire_valid) {
+        pending_.tire_gauge_kilopascal = compute_gauge_kilopascal(pending_.tire_absolute_kilopascal,
+                                                                  pending_.atmospheric_hectopascal);
+        pending_.skew_us = tire_sample_.timestamp_us - atmospheric_timestamp_us_;
+        pending_.skew_uncertainty_us = atmospheric_uncertainty_us_;
+        pending_.timestamp_us = atmospheric_timestamp_us_ + pending_.skew_us / 2;
+    } else if (atmospheric_valid) {
+        pending_.timestamp_us = atmospheric_timestamp_us_;
+    } else if (tire_valid) {
+        pending_.timestamp_us = tire_sample_.timestamp_us;
+    } else {
+        pending_.timestamp_us = now_us;
+    }
+
+    pending_.acquisition_us = (uint32_t)(now_us - start_us_);
+    pending_.sequence = ++sequence_;
+
+    snapshots_++;
+    if (atmospheric_valid && tire_valid) {
+        int64_t skew_us = absolute_skew(pending_.skew_us);
+        max_skew_us_ = (skew_us > max_skew_us_) ? skew_us : max_skew_us_;
+        int64_t skew_bound_us = skew_us + pending_.skew_uncertainty_us;
+        max_skew_bound_us_ = (skew_bound_us > max_skew_bound_us_) ? skew_bound_us : max_skew_bound_us_;
+        total_skew_us_ += skew_us;
+    } else {
+        partial_snapshots_++;
+    }
+    max_acquisition_us_ = (pending_.acquisition_us > max_acquisition_us_) ? pending_.acquisition_us
+                                                                          : max_acquisition_us_;
+    total_acquisition_us_ += pending_.acquisition_us;
+
+    snapshot_ = pending_;
+    active_ = false;
+
+    ESP_LOGD(TAG, "Snapshot %lu: %.1f hPa, %.1f kPa abs, %.1f kPa man, defasagem %lld ±%lu us",
+             (unsigned long)snapshot_.sequence, snapshot_.atmospheric_hectopascal,
+             snapshot_.tire_absolute_kilopascal, snapshot_.tire_gauge_kilopascal, snapshot_.skew_us,
+             (unsigned long)snapshot_.skew_uncertainty_us);
+}
+
+// Com a captura contínua ativa ninguém entrega amostras durante a espera: o
+// registro sai só com a atmosfera (tire_result = ESP_ERR_NOT_FOUND)
+esp_err_t SnapshotEngine::acquire(Snapshot* snapshot) {
+    esp_err_t result = start();
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    // Aguardar a conversão mais longa e depois sondar a cada tick; os drivers
+    // limitam a espera por status ocupado
+    vTaskDelay(pdMS_TO_TICKS((get_ready_time_hint_us() + 999) / 1000));
+
+    bool complete = false;
+    while ((result = poll(&complete)) == ESP_OK && !complete) {
+        vTaskDelay(1);
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    *snapshot = snapshot_;
+    if (snapshot_.atmospheric_result != ESP_OK && snapshot_.tire_result != ESP_OK) {
+        return snapshot_.atmospheric_result;
+    }
+    return ESP_OK;
+}
+
+uint32_t SnapshotEngine::get_ready_time_hint_us() const {
+    if (!active_) {
+        return 0;
+    }
+
+    uint32_t hint_us = 0;
+    if (!atmospheric_done_) {
+        hint_us = bmp280_->get_ready_time_hint_us();
+    }
+    if (!tire_done_ && !tire_external_) {
+        uint32_t tire_hint_us = smp3011_->get_ready_time_hint_ms() * 1000;
+        hint_us = (tire_hint_us > hint_us) ? tire_hint_us : hint_us;
+    }
+    return hint_us;
+}
+
+SnapshotEngine::Stats SnapshotEngine::get_stats() const {
+    Stats stats = {};
+    stats.snapshots = snapshots_;
+    stats.partial_snapshots = partial_snapshots_;
+    stats.max_skew_us = max_skew_us_;
+    stats.max_skew_bound_us = max_skew_bound_us_;
+    stats.max_acquisition_us = max_acquisition_us_;
+
+    uint32_t complete_snapshots = snapshots_ - partial_snapshots_;
+    if (complete_snapshots > 0) {
+        stats.mean_skew_us = total_skew_us_ / complete_snapshots;
+    }
+    if (snapshots_ > 0) {
+        stats.mean_acquisition_us = (uint32_t)(total_acquisition_us_ / snapshots_);
+    }
+    return stats;
+}
+
+void SnapshotEngine::reset_stats() {
+    snapshots_ = 0;
+    partial_snapshots_ = 0;
+    max_skew_us_ = 0;
+    max_skew_bound_us_ = 0;
+    total_skew_us_ = 0;
+    max_acquisition_us_ = 0;
+    total_acquisition_us_ = 0;
+}
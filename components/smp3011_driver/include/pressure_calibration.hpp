@@ -0,0 +1,154 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+// Calibração do SMP3011: curva de pontos (contagens brutas, kPa) interpolada
+// linearmente, com extrapolação pelos segmentos das pontas. A conversão por amostra
+// não percorre a curva: usa uma tabela de segmentos uniformes (base + inclinação)
+// indexada pelos bits altos da contagem, O(1) e sem laço. Um segmento que contém um
+// ponto interno da curva é dividido nele, então a tabela reproduz a curva em toda a
+// faixa (só arredondamento de float); por isso cada segmento aceita no máximo um
+// ponto interno fora das suas fronteiras. A tabela de fábrica é gerada em tempo de
+// compilação; uma curva do usuário pode vir do NVS.
+class PressureCalibration {
+public:
+    static constexpr size_t MAX_CURVE_POINTS = 8;
+    // Faixa de contagens assumida para o sensor (19 bits)
+    static constexpr int RAW_BITS = 19;
+    static constexpr int LUT_SEGMENT_BITS = 6;
+    static constexpr size_t LUT_SEGMENTS = 1u << LUT_SEGMENT_BITS;
+    static constexpr int LUT_SHIFT = RAW_BITS - LUT_SEGMENT_BITS;
+    static constexpr uint32_t LUT_SEGMENT_COUNTS = 1u << LUT_SHIFT;
+
+    struct CurvePoint {
+        uint32_t raw_counts;
+        float pressure_kpa;
+    };
+
+    // Pontos em ordem crescente de contagem; persistida como blob no NVS
+    struct Curve {
+        uint8_t version;
+        uint8_t point_count;
+        CurvePoint points[MAX_CURVE_POINTS];
+    };
+
+    // A partir de split_offset (contagens desde o início do segmento) vale a segunda
+    // reta; sem ponto interno split_offset = LUT_SEGMENT_COUNTS e ela nunca é usada
+    struct LutSegment {
+        float base_kpa;
+        float slope_kpa_per_count;
+        uint32_t split_offset;
+        float split_base_kpa;
+        float split_slope_kpa_per_count;
+    };
+
+    struct Lut {
+        LutSegment segments[LUT_SEGMENTS];
+    };
+
+    static constexpr uint8_t CURVE_VERSION = 1;
+
+    static constexpr Curve make_linear_curve(float min_pressure_kpa, float max_pressure_kpa) {
+        Curve curve = {};
+        curve.version = CURVE_VERSION;
+        curve.point_count = 2;
+        curve.points[0] = {0, min_pressure_kpa};
+        curve.points[1] = {(1u << RAW_BITS) - 1, max_pressure_kpa};
+        return curve;
+    }
+
+    static constexpr bool is_valid_curve(const Curve& curve) {
+        if (curve.version != CURVE_VERSION || curve.point_count < 2 || curve.point_count > MAX_CURVE_POINTS) {
+            return false;
+        }
+        for (size_t i = 1; i < curve.point_count; i++) {
+            if (curve.points[i].raw_counts <= curve.points[i - 1].raw_counts) {
+                return false;
+            }
+        }
+        // Dois pontos internos no mesmo segmento exigiriam duas divisões; um ponto na
+        // fronteira não divide nada
+        for (size_t i = 2; i + 1 < curve.point_count; i++) {
+            uint32_t previous = curve.points[i - 1].raw_counts;
+            if ((previous >> LUT_SHIFT) == (curve.points[i].raw_counts >> LUT_SHIFT) &&
+                (previous & (LUT_SEGMENT_COUNTS - 1)) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static constexpr float evaluate_curve(const Curve& curve, float raw_counts) {
+        // Segmento que contém o ponto; fora da curva usa o primeiro/último
+        size_t segment = 0;
+        while (segment + 2 < curve.point_count && raw_counts > (float)curve.points[segment + 1].raw_counts) {
+            segment++;
+        }
+        const CurvePoint& low = curve.points[segment];
+        const CurvePoint& high = curve.points[segment + 1];
+        float slope = (high.pressure_kpa - low.pressure_kpa) / (float)(high.raw_counts - low.raw_counts);
+        return low.pressure_kpa + slope * (raw_counts - (float)low.raw_counts);
+    }
+
+    // Amostra a curva nas fronteiras dos segmentos e no ponto interno, se houver;
+    // o primeiro e o último ponto não dividem (a extrapolação segue a mesma reta)
+    static constexpr Lut build_lut(const Curve& curve) {
+        Lut lut = {};
+        for (size_t i = 0; i < LUT_SEGMENTS; i++) {
+            uint32_t start = (uint32_t)(i << LUT_SHIFT);
+            uint32_t end = start + LUT_SEGMENT_COUNTS;
+            uint32_t split = end;
+            for (size_t p = 1; p + 1 < curve.point_count; p++) {
+                if (curve.points[p].raw_counts > start && curve.points[p].raw_counts < end) {
+                    split = curve.points[p].raw_counts;
+                }
+            }
+            LutSegment& segment = lut.segments[i];
+            float base = evaluate_curve(curve, (float)start);
+            float split_base = evaluate_curve(curve, (float)split);
+            segment.base_kpa = base;
+            segment.slope_kpa_per_count = (split_base - base) / (float)(split - start);
+            segment.split_offset = split - start;
+            segment.split_base_kpa = split_base;
+            segment.split_slope_kpa_per_count =
+                (split < end) ? (evaluate_curve(curve, (float)end) - split_base) / (float)(end - split) : 0.0f;
+        }
+        return lut;
+    }
+
+    // Fábrica: 0-1000 kPa linear sobre a faixa de contagens
+    static const Curve FACTORY_CURVE;
+    static const Lut FACTORY_LUT;
+
+    PressureCalibration();
+
+    // Contagens acima da faixa extrapolam pelo último segmento
+    float convert(uint32_t raw_counts) const {
+        uint32_t index = raw_counts >> LUT_SHIFT;
+        index = (index < LUT_SEGMENTS) ? index : (uint32_t)(LUT_SEGMENTS - 1);
+        const LutSegment& segment = lut_.segments[index];
+        uint32_t offset = raw_counts - (index << LUT_SHIFT);
+        if (offset >= segment.split_offset) {
+            return segment.split_base_kpa + segment.split_slope_kpa_per_count * (float)(offset - segment.split_offset);
+        }
+        return segment.base_kpa + segment.slope_kpa_per_count * (float)offset;
+    }
+
+    esp_err_t set_curve(const Curve& curve);
+    void reset_to_factory();
+    // Curva do usuário no NVS; ESP_ERR_NOT_FOUND se nenhuma foi salva
+    esp_err_t load_user_curve();
+    esp_err_t save_user_curve(const Curve& curve);
+    esp_err_t erase_user_curve();
+
+    const Curve& get_curve() const { return curve_; }
+    bool is_user_curve() const { return user_curve_; }
+    float get_min_pressure() const;
+    float get_max_pressure() const;
+
+private:
+    Curve curve_;
+    Lut lut_;
+    bool user_curve_;
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// Fila circular lock-free de um produtor e um consumidor (SPSC). O produtor só
+// escreve head_, o consumidor só escreve tail_; cada índice é publicado com
+// release e lido com acquire, então não há seção crítica nem mutex.
+// Capacity precisa ser potência de 2; com a fila cheia a amostra nova é descartada
+// e contada em overruns.
+template <typename T, size_t Capacity>
+class SampleRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity deve ser potência de 2");
+
+public:
+    SampleRing() : head_(0), tail_(0), overruns_(0) {}
+
+    // Lado do produtor
+    bool push(const T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_acquire);
+        if (head - tail >= Capacity) {
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        buffer_[head & (Capacity - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Lado do consumidor
+    bool pop(T* item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+
+        *item = buffer_[tail & (Capacity - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t pop_batch(T* items, size_t max_items) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_acquire);
+        size_t count = head - tail;
+        if (count > max_items) {
+            count = max_items;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            items[i] = buffer_[(tail + i) & (Capacity - 1)];
+        }
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+    uint32_t get_overruns() const { return overruns_.load(std::memory_order_relaxed); }
+
+private:
+    T buffer_[Capacity];
+    std::atomic<size_t> head_;
+    std::atomic<size_t> tail_;
+    std::atomic<uint32_t> overruns_;
+};
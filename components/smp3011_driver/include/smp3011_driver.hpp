@@ -1,17 +1,78 @@
 #pragma once
 #include "esp_err.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "i2c_manager.hpp"
+#include "sample_ring.hpp"
+#include "pressure_calibration.hpp"
 
 class SMP3011Driver {
 public:
+    // Amostra coerente: dados e status do mesmo burst, com o instante da captura
+    struct Sample {
+        uint32_t raw_pressure;
+        float pressure_kilopascal;
+        uint8_t status;
+        int64_t timestamp_us;
+    };
+
+    // Captura contínua: ~1,3 s de histórico a 200 Hz
+    static constexpr size_t CAPTURE_RING_CAPACITY = 256;
+    using CaptureRing = SampleRing<Sample, CAPTURE_RING_CAPACITY>;
+
+    struct CaptureStats {
+        uint32_t ticks;
+        uint32_t samples;
+        uint32_t read_errors;
+        uint32_t missed_ticks;
+        uint32_t ring_overruns;
+        uint64_t period_us;
+    };
+
     SMP3011Driver(I2CManager* i2c_manager, uint8_t device_address);
     ~SMP3011Driver();
 
     esp_err_t initialize_sensor();
     esp_err_t read_pressure(float* pressure_kilopascal);
     esp_err_t read_pressure_detailed(float* pressure_kilopascal, uint32_t* raw_value);
+
+    // Medição em duas fases: start_measurement() dispara a conversão e retorna na hora;
+    // o chamador faz outro trabalho e chama fetch_result() quando poll_ready() indicar
+    esp_err_t start_measurement(uint32_t* ready_in_ms = nullptr);
+    esp_err_t poll_ready(bool* ready);
+    esp_err_t fetch_result(float* pressure_kilopascal, uint32_t* raw_value = nullptr);
+    esp_err_t fetch_sample(Sample* sample);
+    const Sample& get_last_sample() const { return last_sample_; }
+    uint32_t get_ready_time_hint_ms() const;
+    bool is_measurement_pending() const { return measurement_pending_; }
+
+    // Com a verificação ativa o burst inclui o registro de status e amostras
+    // ocupadas/velhas são rejeitadas (bits a validar com o datasheet do sensor)
+    void set_status_check(bool enabled) { status_check_enabled_ = enabled; }
+    // Tempo de conversão assumido entre start_measurement() e o resultado
+    void set_conversion_time_us(uint32_t conversion_time_us);
+    uint32_t get_conversion_time_us() const { return conversion_time_us_; }
+
+    // Captura contínua: um esp_timer periódico acorda uma task que busca a conversão
+    // anterior e dispara a próxima, publicando as amostras em get_capture_ring().
+    // Enquanto ativa, essa task é a única usuária da API de medição do driver.
+    esp_err_t start_continuous_capture(uint32_t rate_hz, UBaseType_t task_priority, uint32_t stack_size);
+    esp_err_t stop_continuous_capture();
+    // Muda o período da captura em andamento (limitado pelo tempo de conversão)
+    esp_err_t set_capture_period_us(uint64_t period_us);
+    bool is_capture_running() const { return capture_task_ != nullptr; }
+    CaptureRing& get_capture_ring() { return capture_ring_; }
+    CaptureStats get_capture_stats() const;
+    // Converte contagens brutas (ex.: já filtradas) para kPa com offset e faixa atuais
+    float convert_raw_to_pressure(uint32_t raw_data) const;
     esp_err_t set_pressure_offset(float offset_kpa);
     esp_err_t set_pressure_range(float min_pressure_kpa, float max_pressure_kpa); // ADD THIS LINE
+    // Curva de calibração multiponto; com persist=true fica salva no NVS e é
+    // carregada de novo em initialize_sensor()
+    esp_err_t set_calibration_curve(const PressureCalibration::Curve& curve, bool persist);
+    esp_err_t reset_calibration();
+    const PressureCalibration& get_calibration() const { return calibration_; }
     esp_err_t scan_sensor_registers();
     bool is_sensor_initialized() const { return sensor_initialized_; }
 
@@ -23,23 +84,57 @@ private:
     // Configurações de medição - MAKE SURE THESE ARE DECLARED
     float minimum_measurement_pressure_;
     float maximum_measurement_pressure_;
-    float pressure_scale_factor_;
+    PressureCalibration calibration_;
     float pressure_offset_;
 
+    // Conversão em andamento
+    bool measurement_pending_;
+    int64_t measurement_start_us_;
+
+    bool status_check_enabled_;
+    uint32_t conversion_time_us_;
+    Sample last_sample_;
+
+    // Captura contínua
+    esp_timer_handle_t capture_timer_;
+    TaskHandle_t capture_task_;
+    // Ticks do timer para a task: semáforo próprio, fora das notificações da task
+    // (a espera síncrona do I2C não pode ser acordada por um tick)
+    StaticSemaphore_t capture_tick_storage_;
+    SemaphoreHandle_t capture_tick_signal_;
+    volatile bool capture_stop_requested_;
+    uint64_t capture_period_us_;
+    CaptureStats capture_stats_;
+    CaptureRing capture_ring_;
+
     // Registros do sensor
     static constexpr uint8_t REGISTER_WHO_AM_I = 0x0F;
     static constexpr uint8_t REGISTER_STATUS = 0x07;
     static constexpr uint8_t REGISTER_DATA_MSB = 0x00;
     static constexpr uint8_t REGISTER_DATA_LSB = 0x01;
     static constexpr uint8_t REGISTER_DATA_XLSB = 0x02;
+    // Burst: dados 0x00..0x02, e com verificação de status até 0x07
+    static constexpr size_t DATA_BURST_LENGTH = 3;
+    static constexpr size_t STATUS_BURST_LENGTH = REGISTER_STATUS - REGISTER_DATA_MSB + 1;
     static constexpr uint8_t REGISTER_CONTROL = 0x08;
     
     static constexpr uint8_t COMMAND_START_MEASUREMENT = 0x01;
     static constexpr uint8_t EXPECTED_WHO_AM_I = 0x30;
+    static constexpr uint32_t DEFAULT_CONVERSION_TIME_US = 20000;
+    // Folga do período de captura sobre a conversão (latência do timer e do barramento)
+    static constexpr uint32_t CAPTURE_TIMING_MARGIN_US = 500;
+    // Ticks acumulados além deste limite se perdem; a task conta os que vê como perdidos
+    static constexpr UBaseType_t CAPTURE_MAX_PENDING_TICKS = 32;
+    static constexpr uint8_t STATUS_BUSY = 0x20;
+    static constexpr uint8_t STATUS_DATA_READY = 0x08;
+
+    static void capture_timer_callback(void* arg);
+    static void capture_task(void* arg);
+    void capture_tick();
+    uint64_t clamp_capture_period_us(uint64_t period_us) const;
 
     esp_err_t configure_sensor_operation();
     esp_err_t verify_sensor_identification();
-    esp_err_t read_raw_pressure_data(uint32_t* raw_pressure);
-    float convert_raw_to_pressure(uint32_t raw_data);
+    esp_err_t read_raw_pressure_data(uint32_t* raw_pressure, uint8_t* status);
     uint32_t combine_pressure_data_bytes(uint8_t msb_byte, uint8_t lsb_byte, uint8_t xlsb_byte);
 };
\ No newline at end of file
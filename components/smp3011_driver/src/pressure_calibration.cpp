@@ -0,0 +1,114 @@
+#include "pressure_calibration.hpp"
+#include "esp_log.h"
+#include "nvs.h"
+
+static const char *TAG = "PressureCalibration";
+static const char *NVS_NAMESPACE = "smp3011_cal";
+static const char *NVS_CURVE_KEY = "curve";
+
+// Geradas pelo compilador: nada da tabela de fábrica é calculado no boot
+constexpr PressureCalibration::Curve PressureCalibration::FACTORY_CURVE =
+    PressureCalibration::make_linear_curve(0.0f, 1000.0f);
+constexpr PressureCalibration::Lut PressureCalibration::FACTORY_LUT =
+    PressureCalibration::build_lut(PressureCalibration::FACTORY_CURVE);
+
+PressureCalibration::PressureCalibration()
+    : curve_(FACTORY_CURVE), lut_(FACTORY_LUT), user_curve_(false) {}
+
+esp_err_t PressureCalibration::set_curve(const Curve& curve) {
+    if (!is_valid_curve(curve)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    curve_ = curve;
+    lut_ = build_lut(curve);
+    user_curve_ = true;
+    return ESP_OK;
+}
+
+void PressureCalibration::reset_to_factory() {
+    curve_ = FACTORY_CURVE;
+    lut_ = FACTORY_LUT;
+    user_curve_ = false;
+}
+
+esp_err_t PressureCalibration::load_user_curve() {
+    nvs_handle_t handle;
+    esp_err_t result = nvs_open(NVS_NAMESPACE, NVS_READONLY, &handle);
+    if (result != ESP_OK) {
+        return (result == ESP_ERR_NVS_NOT_FOUND) ? ESP_ERR_NOT_FOUND : result;
+    }
+
+    Curve curve = {};
+    size_t length = sizeof(Curve);
+    result = nvs_get_blob(handle, NVS_CURVE_KEY, &curve, &length);
+    nvs_close(handle);
+    if (result != ESP_OK) {
+        return (result == ESP_ERR_NVS_NOT_FOUND) ? ESP_ERR_NOT_FOUND : result;
+    }
+
+    if (length != sizeof(Curve) || !is_valid_curve(curve)) {
+        ESP_LOGW(TAG, "Curva do usuário no NVS inválida, mantendo a de fábrica");
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    ESP_LOGI(TAG, "Curva do usuário carregada (%d pontos)", curve.point_count);
+    return set_curve(curve);
+}
+
+esp_err_t PressureCalibration::save_user_curve(const Curve& curve) {
+    esp_err_t result = set_curve(curve);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    nvs_handle_t handle;
+    result = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    result = nvs_set_blob(handle, NVS_CURVE_KEY, &curve, sizeof(Curve));
+    if (result == ESP_OK) {
+        result = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return result;
+}
+
+esp_err_t PressureCalibration::erase_user_curve() {
+    reset_to_factory();
+
+    nvs_handle_t handle;
+    esp_err_t result = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    result = nvs_erase_key(handle, NVS_CURVE_KEY);
+    if (result == ESP_OK) {
+        result = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return result;
+}
+
+float PressureCalibration::get_min_pressure() const {
+    float minimum = curve_.points[0].pressure_kpa;
+    for (size_t i = 1; i < curve_.point_count; i++) {
+        if (curve_.points[i].pressure_kpa < minimum) {
+            minimum = curve_.points[i].pressure_kpa;
+        }
+    }
+    return minimum;
+}
+
+float PressureCalibration::get_max_pressure() const {
+    float maximum = curve_.points[0].pressure_kpa;
+    for (size_t i = 1; i < curve_.point_count; i++) {
+        if (curve_.points[i].pressure_kpa > maximum) {
+            maximum = curve_.points[i].pressure_kpa;
+        }
+    }
+    return maximum;
+}
@@ -1,5 +1,6 @@
 #include "smp3011_driver.hpp"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include <cstring>
 
 static const char *TAG = "SMP3011Driver";
@@ -10,10 +11,21 @@ SMP3011Driver::SMP3011Driver(I2CManager* i2c_manager, uint8_t device_address)
       sensor_initialized_(false),
       minimum_measurement_pressure_(0.0f),
       maximum_measurement_pressure_(1000.0f),
-      pressure_scale_factor_(0.0f),
-      pressure_offset_(0.0f) {}
+      pressure_offset_(0.0f),
+      measurement_pending_(false),
+      measurement_start_us_(0),
+      status_check_enabled_(false),
+      conversion_time_us_(DEFAULT_CONVERSION_TIME_US),
+      last_sample_{},
+      capture_timer_(nullptr),
+      capture_task_(nullptr),
+      capture_tick_signal_(nullptr),
+      capture_stop_requested_(false),
+      capture_period_us_(0),
+      capture_stats_{} {}
 
 SMP3011Driver::~SMP3011Driver() {
+    stop_continuous_capture();
     ESP_LOGI(TAG, "Driver SMP3011 finalizado");
 }
 
@@ -29,6 +41,12 @@ esp_err_t SMP3011Driver::initialize_sensor() {
 
     ESP_LOGI(TAG, "Comunicação básica com SMP3011 verificada");
 
+    // Leituras do sensor têm prioridade máxima no barramento
+    i2c_manager_->set_device_priority(device_address_, I2CManager::BusPriority::SENSOR_ACQUISITION);
+
+    // Limite conservador: fast mode
+    i2c_manager_->set_device_max_speed(device_address_, I2CManager::BusSpeed::FAST);
+
     // Tentar identificar o sensor
     esp_err_t id_result = verify_sensor_identification();
     if (id_result != ESP_OK) {
@@ -36,9 +54,17 @@ esp_err_t SMP3011Driver::initialize_sensor() {
         // Continuar mesmo sem identificação - sensor pode não ter registro WHO_AM_I
     }
 
-    // Configurar faixa de pressão
+    // Calibração: curva do usuário salva no NVS, ou a tabela de fábrica
     ESP_ERROR_CHECK(set_pressure_offset(0.0f)); // Resetar offset
-    ESP_ERROR_CHECK(set_pressure_range(0.0f, 1000.0f));
+    calibration_.reset_to_factory();
+    esp_err_t calibration_result = calibration_.load_user_curve();
+    if (calibration_result != ESP_OK && calibration_result != ESP_ERR_NOT_FOUND) {
+        ESP_LOGW(TAG, "Curva do usuário indisponível (%s), usando a de fábrica", esp_err_to_name(calibration_result));
+    }
+    minimum_measurement_pressure_ = calibration_.get_min_pressure();
+    maximum_measurement_pressure_ = calibration_.get_max_pressure();
+    ESP_LOGI(TAG, "Calibração %s: %d pontos, %.1f-%.1f kPa", calibration_.is_user_curve() ? "do usuário" : "de fábrica",
+             calibration_.get_curve().point_count, minimum_measurement_pressure_, maximum_measurement_pressure_);
 
     // Configurar operação
     esp_err_t config_result = configure_sensor_operation();
@@ -47,25 +73,24 @@ esp_err_t SMP3011Driver::initialize_sensor() {
         return config_result;
     }
 
-    // Fazer uma leitura teste
+    // Fazer uma leitura teste (read_pressure_detailed exige o sensor marcado como inicializado)
     float test_pressure;
     uint32_t raw_value;
+    sensor_initialized_ = true;
     esp_err_t test_result = read_pressure_detailed(&test_pressure, &raw_value);
     
     if (test_result == ESP_OK) {
         ESP_LOGI(TAG, "Leitura teste: %.2f kPa (raw: %lu)", test_pressure, raw_value);
-        
-        // Se a leitura for 0.0, adicionar um offset de calibração de teste
+
         if (test_pressure < 1.0f) {
-            ESP_LOGW(TAG, "Leitura muito baixa, aplicando offset de calibração de teste");
-            set_pressure_offset(250.0f); // 250 kPa = ~2.5 bar
+            ESP_LOGW(TAG, "Leitura muito baixa: verificar a curva de calibração do sensor");
         }
     } else {
         ESP_LOGE(TAG, "Falha na leitura teste do sensor");
+        sensor_initialized_ = false;
         return test_result;
     }
 
-    sensor_initialized_ = true;
     ESP_LOGI(TAG, "SMP3011 inicializado com sucesso");
     return ESP_OK;
 }
@@ -113,19 +138,42 @@ esp_err_t SMP3011Driver::set_pressure_range(float min_pressure_kpa, float max_pr
         return ESP_ERR_INVALID_ARG;
     }
 
+    // Curva linear de dois pontos sobre a faixa de contagens (19 bits)
+    esp_err_t result = calibration_.set_curve(PressureCalibration::make_linear_curve(min_pressure_kpa, max_pressure_kpa));
+    if (result != ESP_OK) {
+        return result;
+    }
     minimum_measurement_pressure_ = min_pressure_kpa;
     maximum_measurement_pressure_ = max_pressure_kpa;
-    
-    // Calcular fator de escala (assumindo 19 bits como BMP280)
-    const uint32_t max_raw_value = 524287; // 2^19 - 1
-    pressure_scale_factor_ = (max_pressure_kpa - min_pressure_kpa) / max_raw_value;
 
-    ESP_LOGI(TAG, "Faixa configurada: %.1f-%.1f kPa, escala: %.6f kPa/bit", 
-             min_pressure_kpa, max_pressure_kpa, pressure_scale_factor_);
+    ESP_LOGI(TAG, "Faixa configurada: %.1f-%.1f kPa, escala: %.6f kPa/bit", min_pressure_kpa, max_pressure_kpa,
+             (max_pressure_kpa - min_pressure_kpa) / ((1u << PressureCalibration::RAW_BITS) - 1));
     
     return ESP_OK;
 }
 
+esp_err_t SMP3011Driver::set_calibration_curve(const PressureCalibration::Curve& curve, bool persist) {
+    esp_err_t result = persist ? calibration_.save_user_curve(curve) : calibration_.set_curve(curve);
+    if (result != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao aplicar curva de calibração: %s", esp_err_to_name(result));
+        return result;
+    }
+
+    minimum_measurement_pressure_ = calibration_.get_min_pressure();
+    maximum_measurement_pressure_ = calibration_.get_max_pressure();
+    ESP_LOGI(TAG, "Curva de calibração aplicada: %d pontos, %.1f-%.1f kPa%s", curve.point_count,
+             minimum_measurement_pressure_, maximum_measurement_pressure_, persist ? " (salva no NVS)" : "");
+    return ESP_OK;
+}
+
+esp_err_t SMP3011Driver::reset_calibration() {
+    esp_err_t result = calibration_.erase_user_curve();
+    minimum_measurement_pressure_ = calibration_.get_min_pressure();
+    maximum_measurement_pressure_ = calibration_.get_max_pressure();
+    ESP_LOGI(TAG, "Calibração de fábrica restaurada");
+    return result;
+}
+
 esp_err_t SMP3011Driver::set_pressure_offset(float offset_kpa) {
     pressure_offset_ = offset_kpa;
     ESP_LOGI(TAG, "Offset de pressão configurado: %.2f kPa", offset_kpa);
@@ -138,6 +186,32 @@ esp_err_t SMP3011Driver::read_pressure(float* pressure_kilopascal) {
 }
 
 esp_err_t SMP3011Driver::read_pressure_detailed(float* pressure_kilopascal, uint32_t* raw_value) {
+    // Versão bloqueante sobre a API de duas fases
+    uint32_t ready_in_ms = 0;
+    esp_err_t start_result = start_measurement(&ready_in_ms);
+    if (start_result != ESP_OK) {
+        return start_result;
+    }
+
+    // Aguardar conversão
+    vTaskDelay(pdMS_TO_TICKS(ready_in_ms));
+
+    bool ready = false;
+    while (poll_ready(&ready) == ESP_OK && !ready) {
+        vTaskDelay(1);
+    }
+
+    // Status ainda ocupado: fetch_result devolve NOT_FINISHED até o limite de espera
+    esp_err_t fetch_status = fetch_result(pressure_kilopascal, raw_value);
+    while (fetch_status == ESP_ERR_NOT_FINISHED) {
+        vTaskDelay(1);
+        fetch_status = fetch_result(pressure_kilopascal, raw_value);
+    }
+
+    return fetch_status;
+}
+
+esp_err_t SMP3011Driver::start_measurement(uint32_t* ready_in_ms) {
     if (!sensor_initialized_) {
         return ESP_ERR_INVALID_STATE;
     }
@@ -146,44 +220,283 @@ esp_err_t SMP3011Driver::read_pressure_detailed(float* pressure_kilopascal, uint
     esp_err_t cmd_result = i2c_manager_->write_register(device_address_, REGISTER_CONTROL, COMMAND_START_MEASUREMENT);
     if (cmd_result != ESP_OK) {
         ESP_LOGE(TAG, "Falha ao iniciar medição: %s", esp_err_to_name(cmd_result));
+        measurement_pending_ = false;
         return cmd_result;
     }
 
-    // Aguardar conversão
-    vTaskDelay(pdMS_TO_TICKS(20));
+    measurement_pending_ = true;
+    measurement_start_us_ = esp_timer_get_time();
+
+    if (ready_in_ms != nullptr) {
+        *ready_in_ms = (conversion_time_us_ + 999) / 1000;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t SMP3011Driver::poll_ready(bool* ready) {
+    if (!measurement_pending_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Só o tempo de conversão; não gera tráfego no barramento
+    *ready = get_ready_time_hint_ms() == 0;
+    return ESP_OK;
+}
+
+uint32_t SMP3011Driver::get_ready_time_hint_ms() const {
+    if (!measurement_pending_) {
+        return 0;
+    }
+
+    int64_t remaining_us = (int64_t)conversion_time_us_ - (esp_timer_get_time() - measurement_start_us_);
+    return (remaining_us <= 0) ? 0 : (uint32_t)((remaining_us + 999) / 1000);
+}
+
+esp_err_t SMP3011Driver::fetch_result(float* pressure_kilopascal, uint32_t* raw_value) {
+    Sample sample;
+    esp_err_t result = fetch_sample(&sample);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    *pressure_kilopascal = sample.pressure_kilopascal;
+    if (raw_value != nullptr) {
+        *raw_value = sample.raw_pressure;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t SMP3011Driver::fetch_sample(Sample* sample) {
+    if (!measurement_pending_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (get_ready_time_hint_ms() > 0) {
+        return ESP_ERR_NOT_FINISHED;
+    }
 
     // Ler dados brutos
-    esp_err_t read_result = read_raw_pressure_data(raw_value);
+    Sample captured = {};
+    captured.timestamp_us = esp_timer_get_time();
+    esp_err_t read_result = read_raw_pressure_data(&captured.raw_pressure, &captured.status);
+    if (read_result == ESP_ERR_NOT_FINISHED) {
+        // Sensor ainda convertendo: a medição continua pendente, até o dobro do tempo nominal
+        if (captured.timestamp_us - measurement_start_us_ < 2 * (int64_t)conversion_time_us_) {
+            return read_result;
+        }
+        ESP_LOGW(TAG, "Conversão não terminou em %lu us", (unsigned long)(2 * conversion_time_us_));
+        read_result = ESP_ERR_TIMEOUT;
+    }
+
+    measurement_pending_ = false;
     if (read_result != ESP_OK) {
         return read_result;
     }
 
     // Converter para kPa
-    *pressure_kilopascal = convert_raw_to_pressure(*raw_value);
+    captured.pressure_kilopascal = convert_raw_to_pressure(captured.raw_pressure);
+    last_sample_ = captured;
+    *sample = captured;
 
-    ESP_LOGD(TAG, "Leitura - Bruto: %lu, Convertido: %.2f kPa", *raw_value, *pressure_kilopascal);
+    ESP_LOGD(TAG, "Leitura - Bruto: %lu, Convertido: %.2f kPa", captured.raw_pressure, captured.pressure_kilopascal);
     
     return ESP_OK;
 }
 
-esp_err_t SMP3011Driver::read_raw_pressure_data(uint32_t* raw_pressure) {
-    uint8_t msb, lsb, xlsb;
-    
-    // Ler os três bytes de dados
-    esp_err_t result_msb = i2c_manager_->read_register(device_address_, REGISTER_DATA_MSB, &msb, 1);
-    esp_err_t result_lsb = i2c_manager_->read_register(device_address_, REGISTER_DATA_LSB, &lsb, 1);
-    esp_err_t result_xlsb = i2c_manager_->read_register(device_address_, REGISTER_DATA_XLSB, &xlsb, 1);
+void SMP3011Driver::set_conversion_time_us(uint32_t conversion_time_us) {
+    conversion_time_us_ = (conversion_time_us > 0) ? conversion_time_us : DEFAULT_CONVERSION_TIME_US;
+}
+
+esp_err_t SMP3011Driver::start_continuous_capture(uint32_t rate_hz, UBaseType_t task_priority, uint32_t stack_size) {
+    if (!sensor_initialized_ || rate_hz == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
 
-    if (result_msb != ESP_OK || result_lsb != ESP_OK || result_xlsb != ESP_OK) {
-        ESP_LOGE(TAG, "Erro na leitura de dados: MSB=%s, LSB=%s, XLSB=%s",
-                esp_err_to_name(result_msb), esp_err_to_name(result_lsb), esp_err_to_name(result_xlsb));
-        return ESP_ERR_INVALID_RESPONSE;
+    if (capture_task_ != nullptr) {
+        return ESP_OK;
     }
 
-    ESP_LOGD(TAG, "Bytes lidos: MSB=0x%02X, LSB=0x%02X, XLSB=0x%02X", msb, lsb, xlsb);
+    capture_period_us_ = clamp_capture_period_us(1000000ull / rate_hz);
+    if (capture_period_us_ > 1000000ull / rate_hz) {
+        ESP_LOGW(TAG, "Taxa de %lu Hz acima do limite da conversão (%lu us), usando %lu Hz",
+                 (unsigned long)rate_hz, (unsigned long)conversion_time_us_,
+                 (unsigned long)(1000000 / capture_period_us_));
+    }
+    capture_stats_ = {};
+    capture_stop_requested_ = false;
+
+    if (capture_tick_signal_ == nullptr) {
+        capture_tick_signal_ = xSemaphoreCreateCountingStatic(CAPTURE_MAX_PENDING_TICKS, 0, &capture_tick_storage_);
+    }
+    // Ticks que sobraram de uma captura anterior não valem para esta
+    while (xSemaphoreTake(capture_tick_signal_, 0) == pdTRUE) {
+    }
+
+    if (xTaskCreate(capture_task, "smp3011_capture", stack_size, this, task_priority, &capture_task_) != pdPASS) {
+        ESP_LOGE(TAG, "Falha ao criar task de captura");
+        capture_task_ = nullptr;
+        return ESP_ERR_NO_MEM;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = capture_timer_callback,
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "smp3011_capture",
+        .skip_unhandled_events = true,
+    };
+    esp_err_t result = esp_timer_create(&timer_args, &capture_timer_);
+    if (result == ESP_OK) {
+        result = esp_timer_start_periodic(capture_timer_, capture_period_us_);
+    }
+    if (result != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao iniciar timer de captura: %s", esp_err_to_name(result));
+        stop_continuous_capture();
+        return result;
+    }
+
+    ESP_LOGI(TAG, "Captura contínua a cada %lu us", (unsigned long)capture_period_us_);
+    return ESP_OK;
+}
+
+esp_err_t SMP3011Driver::set_capture_period_us(uint64_t period_us) {
+    if (capture_timer_ == nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    period_us = clamp_capture_period_us(period_us);
+    if (period_us == capture_period_us_) {
+        return ESP_OK;
+    }
+
+    esp_err_t result = esp_timer_restart(capture_timer_, period_us);
+    if (result == ESP_OK) {
+        capture_period_us_ = period_us;
+    }
+    return result;
+}
+
+// Cada período busca a conversão anterior e dispara a próxima: o período
+// não pode ser menor que o tempo de conversão
+uint64_t SMP3011Driver::clamp_capture_period_us(uint64_t period_us) const {
+    uint64_t min_period_us = conversion_time_us_ + CAPTURE_TIMING_MARGIN_US;
+    return (period_us < min_period_us) ? min_period_us : period_us;
+}
+
+esp_err_t SMP3011Driver::stop_continuous_capture() {
+    if (capture_timer_ != nullptr) {
+        esp_timer_stop(capture_timer_);
+        esp_timer_delete(capture_timer_);
+        capture_timer_ = nullptr;
+    }
+
+    if (capture_task_ == nullptr) {
+        return ESP_OK;
+    }
+
+    // A task termina a transação em andamento e se apaga; só então o driver volta a ser livre
+    capture_stop_requested_ = true;
+    xSemaphoreGive(capture_tick_signal_);
+    while (capture_task_ != nullptr) {
+        vTaskDelay(1);
+    }
+
+    measurement_pending_ = false;
+    ESP_LOGI(TAG, "Captura contínua parada: %lu amostras", (unsigned long)capture_stats_.samples);
+    return ESP_OK;
+}
+
+SMP3011Driver::CaptureStats SMP3011Driver::get_capture_stats() const {
+    CaptureStats stats = capture_stats_;
+    stats.ring_overruns = capture_ring_.get_overruns();
+    stats.period_us = capture_period_us_;
+    return stats;
+}
+
+// Contexto da task do esp_timer: só acorda a task de captura, sem I2C aqui
+void SMP3011Driver::capture_timer_callback(void* arg) {
+    SMP3011Driver* driver = static_cast<SMP3011Driver*>(arg);
+    xSemaphoreGive(driver->capture_tick_signal_);
+}
+
+void SMP3011Driver::capture_task(void* arg) {
+    SMP3011Driver* driver = static_cast<SMP3011Driver*>(arg);
+
+    while (true) {
+        xSemaphoreTake(driver->capture_tick_signal_, portMAX_DELAY);
+        if (driver->capture_stop_requested_) {
+            break;
+        }
+
+        uint32_t pending_ticks = 1;
+        while (xSemaphoreTake(driver->capture_tick_signal_, 0) == pdTRUE) {
+            pending_ticks++;
+        }
+
+        // Mais de uma notificação acumulada: a task atrasou e perdeu períodos
+        if (pending_ticks > 1) {
+            driver->capture_stats_.missed_ticks += pending_ticks - 1;
+        }
+        driver->capture_tick();
+    }
+
+    driver->capture_task_ = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void SMP3011Driver::capture_tick() {
+    capture_stats_.ticks++;
+
+    if (measurement_pending_) {
+        Sample sample;
+        esp_err_t result = fetch_sample(&sample);
+        if (result == ESP_ERR_NOT_FINISHED) {
+            // Conversão ainda em andamento: tenta no próximo período
+            return;
+        }
+
+        if (result == ESP_OK) {
+            capture_stats_.samples++;
+            capture_ring_.push(sample);
+        } else {
+            capture_stats_.read_errors++;
+        }
+    }
+
+    if (start_measurement() != ESP_OK) {
+        capture_stats_.read_errors++;
+    }
+}
+
+// Um único burst a partir de 0x00: os bytes saem do mesmo instante do sensor, sem
+// risco de misturar MSB de uma conversão com LSB da seguinte
+esp_err_t SMP3011Driver::read_raw_pressure_data(uint32_t* raw_pressure, uint8_t* status) {
+    uint8_t burst[STATUS_BURST_LENGTH];
+    size_t burst_length = status_check_enabled_ ? STATUS_BURST_LENGTH : DATA_BURST_LENGTH;
+
+    esp_err_t result = i2c_manager_->read_register(device_address_, REGISTER_DATA_MSB, burst, burst_length);
+    if (result != ESP_OK) {
+        ESP_LOGE(TAG, "Erro na leitura de dados: %s", esp_err_to_name(result));
+        return result;
+    }
+
+    ESP_LOGD(TAG, "Bytes lidos: MSB=0x%02X, LSB=0x%02X, XLSB=0x%02X", burst[0], burst[1], burst[2]);
+
+    *status = status_check_enabled_ ? burst[REGISTER_STATUS - REGISTER_DATA_MSB] : 0;
+    if (status_check_enabled_) {
+        if (*status & STATUS_BUSY) {
+            return ESP_ERR_NOT_FINISHED;
+        }
+        if (!(*status & STATUS_DATA_READY)) {
+            ESP_LOGW(TAG, "Amostra velha rejeitada (status 0x%02X)", *status);
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+    }
 
     // Combinar bytes (formato similar ao BMP280)
-    *raw_pressure = combine_pressure_data_bytes(msb, lsb, xlsb);
+    *raw_pressure = combine_pressure_data_bytes(burst[0], burst[1], burst[2]);
     
     return ESP_OK;
 }
@@ -213,17 +526,12 @@ uint32_t SMP3011Driver::combine_pressure_data_bytes(uint8_t msb_byte, uint8_t ls
     return combined;
 }
 
-float SMP3011Driver::convert_raw_to_pressure(uint32_t raw_data) {
-    // Converter valor bruto para kPa
-    float pressure = minimum_measurement_pressure_ + (raw_data * pressure_scale_factor_);
-    pressure += pressure_offset_; // Aplicar offset de calibração
-    
+float SMP3011Driver::convert_raw_to_pressure(uint32_t raw_data) const {
+    // Converter valor bruto para kPa pela tabela da curva de calibração
+    float pressure = calibration_.convert(raw_data) + pressure_offset_; // Aplicar offset de calibração
+
     // Limitar à faixa configurada
-    if (pressure < minimum_measurement_pressure_) {
-        pressure = minimum_measurement_pressure_;
-    } else if (pressure > maximum_measurement_pressure_) {
-        pressure = maximum_measurement_pressure_;
-    }
-    
+    pressure = (pressure < minimum_measurement_pressure_) ? minimum_measurement_pressure_ : pressure;
+    pressure = (pressure > maximum_measurement_pressure_) ? maximum_measurement_pressure_ : pressure;
     return pressure;
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include "oled_display.hpp"
 #include "bmp280_driver.hpp"
 #include "smp3011_driver.hpp"
+#include "adaptive_rate_controller.hpp"
+#include "pressure_filter.hpp"
+#include "snapshot_engine.hpp"
 
 class SystemController {
 public:
@@ -10,8 +13,10 @@ public:
         QUICK_READ,
         DETAILED_READ, 
         CALIBRATION,
-        SETTINGS
+        SETTINGS,
+        PRESSURE_TREND
     };
+    static constexpr int OPERATION_MODE_COUNT = 5;
 
     SystemController(ButtonDriver* buttons, OLEDDisplay* display,
                     BMP280Driver* bmp280, SMP3011Driver* smp3011);
@@ -21,6 +26,13 @@ public:
     void process_events();
     void update_display();
 
+    // Taxa adaptativa de amostragem do pneu
+    void configure_sample_rate(const AdaptiveRateController::Config& config);
+    AdaptiveRateController::Stats get_sample_rate_stats() const { return rate_controller_.get_stats(); }
+    // Leitura coerente atmosfera + pneu
+    const SnapshotEngine::Snapshot& get_current_snapshot() const { return current_snapshot_; }
+    SnapshotEngine::Stats get_snapshot_stats() const { return snapshot_engine_.get_stats(); }
+
 private:
     ButtonDriver* buttons_;
     OLEDDisplay* display_;
@@ -29,9 +41,16 @@ private:
 
     OperationMode current_mode_;
     uint32_t last_sensor_read_;
-    float current_temperature_;
-    float current_atmospheric_pressure_;
-    float current_tire_pressure_;
+    // Último registro dos dois sensores e pressão absoluta do pneu já filtrada
+    SnapshotEngine snapshot_engine_;
+    SnapshotEngine::Snapshot current_snapshot_;
+    float filtered_tire_pressure_;
+    AdaptiveRateController rate_controller_;
+    // Filtro da pressão exibida: mediana contra picos e Kalman contra ruído, sobre
+    // as contagens brutas do SMP3011
+    MedianFilter tire_median_;
+    KalmanFilter tire_kalman_;
+    FilterPipeline tire_filter_;
 
     // Estado da calibração
     bool calibration_active_;
@@ -39,7 +58,17 @@ private:
 
     void handle_button_event(const ButtonDriver::ButtonEvent& event);
     void change_mode(OperationMode new_mode);
+    void apply_atmospheric_profile();
     void read_sensors();
+    void start_sensor_cycle();
+    bool complete_sensor_cycle();
+    void apply_snapshot(const SnapshotEngine::Snapshot& snapshot);
+    float get_displayed_tire_pressure() const;
+    StatusIconWidget::Icon get_status_icon() const;
+    esp_err_t consume_captured_samples();
+    void record_tire_sample(int64_t timestamp_us, float pressure_kpa);
+    void apply_sample_rate();
+    uint32_t get_sensor_read_interval_ms() const;
     void start_calibration();
     void stop_calibration();
     void apply_calibration(float offset);
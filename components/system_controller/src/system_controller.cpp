@@ -6,7 +6,14 @@
 static const char *TAG = "SystemController";
 
 // Configurações do sistema
-constexpr uint32_t SENSOR_READ_INTERVAL_MS = 2000;
+// Piso do intervalo de leitura/atualização da tela; com a taxa adaptativa alta a
+// captura contínua amostra mais rápido, mas a tela não precisa acompanhar
+constexpr uint32_t MIN_SENSOR_READ_INTERVAL_MS = 200;
+// Filtro da pressão do pneu: variância do ruído do sensor (contagens²) e deriva
+// por amostra; Q = R/8 dá ganho ~0,3, acomodando um degrau em ~7 amostras
+constexpr uint8_t TIRE_MEDIAN_WINDOW = 3;
+constexpr uint32_t TIRE_MEASUREMENT_NOISE = 1600;
+constexpr uint32_t TIRE_PROCESS_NOISE = TIRE_MEASUREMENT_NOISE / 8;
 constexpr uint32_t BUTTON_DEBOUNCE_MS = 50;
 constexpr uint32_t BUTTON_LONG_PRESS_MS = 1000;
 constexpr uint32_t BUTTON_VERY_LONG_PRESS_MS = 3000;
@@ -15,8 +22,12 @@ SystemController::SystemController(ButtonDriver* buttons, OLEDDisplay* display,
                                  BMP280Driver* bmp280, SMP3011Driver* smp3011)
     : buttons_(buttons), display_(display), bmp280_(bmp280), smp3011_(smp3011),
       current_mode_(OperationMode::QUICK_READ), last_sensor_read_(0),
-      current_temperature_(0), current_atmospheric_pressure_(0), current_tire_pressure_(0),
-      calibration_active_(false), calibration_offset_(0) {}
+      snapshot_engine_(bmp280, smp3011), current_snapshot_{}, filtered_tire_pressure_(0),
+      tire_median_(TIRE_MEDIAN_WINDOW), tire_kalman_(TIRE_PROCESS_NOISE, TIRE_MEASUREMENT_NOISE),
+      calibration_active_(false), calibration_offset_(0) {
+    tire_filter_.add_stage(&tire_median_);
+    tire_filter_.add_stage(&tire_kalman_);
+}
 
 SystemController::~SystemController() {
     ESP_LOGI(TAG, "Controlador do sistema finalizado");
@@ -32,6 +43,12 @@ esp_err_t SystemController::initialize() {
 
     // Mostrar modo atual
     show_current_mode();
+    apply_atmospheric_profile();
+
+    // Primeira leitura imediata, sem esperar o primeiro intervalo do loop
+    read_sensors();
+    update_display();
+    last_sensor_read_ = xTaskGetTickCount() * portTICK_PERIOD_MS;
 
     ESP_LOGI(TAG, "Controlador do sistema inicializado");
     return ESP_OK;
@@ -46,11 +63,15 @@ void SystemController::process_events() {
 
     // Atualizar leituras dos sensores periodicamente
     uint32_t current_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    if (current_time - last_sensor_read_ > SENSOR_READ_INTERVAL_MS) {
-        read_sensors();
-        update_display();
+    if (!snapshot_engine_.is_active() && current_time - last_sensor_read_ > get_sensor_read_interval_ms()) {
+        start_sensor_cycle();
         last_sensor_read_ = current_time;
     }
+
+    // Conversões dos dois sensores terminaram: completar o ciclo e atualizar a tela
+    if (snapshot_engine_.is_active() && complete_sensor_cycle()) {
+        update_display();
+    }
 }
 
 void SystemController::handle_button_event(const ButtonDriver::ButtonEvent& event) {
@@ -62,7 +83,7 @@ void SystemController::handle_button_event(const ButtonDriver::ButtonEvent& even
             if (event.press_type == ButtonDriver::PressType::SHORT_PRESS) {
                 // Ciclar entre modos
                 OperationMode next_mode = static_cast<OperationMode>(
-                    (static_cast<int>(current_mode_) + 1) % 4);
+                    (static_cast<int>(current_mode_) + 1) % OPERATION_MODE_COUNT);
                 change_mode(next_mode);
             } else if (event.press_type == ButtonDriver::PressType::LONG_PRESS) {
                 // Ativar/desativar calibração
@@ -99,27 +120,169 @@ void SystemController::change_mode(OperationMode new_mode) {
     current_mode_ = new_mode;
     ESP_LOGI(TAG, "Modo alterado para: %d", static_cast<int>(new_mode));
     show_current_mode();
+    apply_atmospheric_profile();
     
     // Atualizar display imediatamente
     update_display();
 }
 
+// Referência atmosférica no orçamento de cada modo: leitura rápida e configurações
+// usam conversões forçadas (sensor dorme entre leituras); leitura detalhada e
+// calibração pedem a maior resolução com filtro IIR
+void SystemController::apply_atmospheric_profile() {
+    BMP280Driver::MeasurementProfile profile = BMP280Driver::MeasurementProfile::LOW_POWER;
+    if (current_mode_ == OperationMode::DETAILED_READ || current_mode_ == OperationMode::CALIBRATION) {
+        profile = BMP280Driver::MeasurementProfile::HIGH_RESOLUTION;
+    }
+
+    if (bmp280_->is_sensor_initialized() && bmp280_->set_profile(profile) != ESP_OK) {
+        ESP_LOGW(TAG, "Falha ao aplicar perfil do BMP280");
+    }
+}
+
+// Leitura bloqueante (inicialização): ciclo completo aguardando as conversões
 void SystemController::read_sensors() {
-    // Ler BMP280
-    if (bmp280_->read_temperature_and_pressure(&current_temperature_, &current_atmospheric_pressure_) != ESP_OK) {
+    start_sensor_cycle();
+
+    // Os drivers limitam a espera por status ocupado
+    while (snapshot_engine_.is_active()) {
+        uint32_t wait_us = snapshot_engine_.get_ready_time_hint_us();
+        vTaskDelay(pdMS_TO_TICKS((wait_us + 999) / 1000) + 1);
+        complete_sensor_cycle();
+    }
+}
+
+// Dispara as conversões dos dois sensores juntas. Com a captura contínua ativa
+// quem dispara as do SMP3011 é a task de captura.
+void SystemController::start_sensor_cycle() {
+    esp_err_t result = snapshot_engine_.start();
+    if (result != ESP_OK) {
+        ESP_LOGE(TAG, "Erro ao iniciar leitura dos sensores: %s", esp_err_to_name(result));
+    }
+}
+
+// Retorna false se algum sensor ainda está convertendo (o ciclo continua na próxima passada)
+bool SystemController::complete_sensor_cycle() {
+    if (smp3011_->is_capture_running()) {
+        // A captura e o ciclo da tela têm períodos independentes: sem amostra nova
+        // a tela mantém a última leitura
+        if (consume_captured_samples() != ESP_OK) {
+            ESP_LOGD(TAG, "Nenhuma amostra nova do SMP3011");
+        }
+    }
+
+    bool complete = false;
+    if (snapshot_engine_.poll(&complete) != ESP_OK || !complete) {
+        return false;
+    }
+
+    apply_snapshot(snapshot_engine_.get_snapshot());
+    return true;
+}
+
+void SystemController::apply_snapshot(const SnapshotEngine::Snapshot& snapshot) {
+    if (snapshot.atmospheric_result != ESP_OK) {
         ESP_LOGE(TAG, "Erro na leitura do BMP280");
-        current_temperature_ = 0;
-        current_atmospheric_pressure_ = 0;
     }
 
-    // Ler SMP3011
-    if (smp3011_->read_pressure(&current_tire_pressure_) != ESP_OK) {
-        ESP_LOGE(TAG, "Erro na leitura do SMP3011");
-        current_tire_pressure_ = 0;
+    // Com a captura contínua o filtro já correu em consume_captured_samples()
+    if (!smp3011_->is_capture_running()) {
+        if (snapshot.tire_result != ESP_OK) {
+            ESP_LOGE(TAG, "Erro na leitura do SMP3011");
+            filtered_tire_pressure_ = 0;
+        } else {
+            record_tire_sample(snapshot.timestamp_us, snapshot.tire_absolute_kilopascal);
+
+            int32_t filtered = (int32_t)snapshot.raw_tire;
+            tire_filter_.process(&filtered, 1);
+            filtered_tire_pressure_ = smp3011_->convert_raw_to_pressure((uint32_t)filtered);
+        }
+    }
+
+    current_snapshot_ = snapshot;
+
+    ESP_LOGD(TAG, "Leituras: Temp=%.1fC, Atm=%.1fhPa, Pneu=%.1fkPa (defasagem %lld ±%lu us)",
+             snapshot.temperature_celsius, snapshot.atmospheric_hectopascal, get_displayed_tire_pressure(),
+             snapshot.skew_us, (unsigned long)snapshot.skew_uncertainty_us);
+}
+
+// Pressão manométrica sobre a atmosfera do mesmo registro; sem leitura do BMP280
+// mostra a absoluta
+float SystemController::get_displayed_tire_pressure() const {
+    if (current_snapshot_.atmospheric_result != ESP_OK) {
+        return filtered_tire_pressure_;
+    }
+    return SnapshotEngine::compute_gauge_kilopascal(filtered_tire_pressure_,
+                                                    current_snapshot_.atmospheric_hectopascal);
+}
+
+// Pneu sem leitura é erro; sem BMP280 a pressão exibida é absoluta, só um aviso
+StatusIconWidget::Icon SystemController::get_status_icon() const {
+    if (current_snapshot_.tire_result != ESP_OK) {
+        return StatusIconWidget::Icon::ERROR;
+    }
+    if (current_snapshot_.atmospheric_result != ESP_OK) {
+        return StatusIconWidget::Icon::WARNING;
+    }
+    return StatusIconWidget::Icon::OK;
+}
+
+// Esvazia o ring da captura contínua em blocos: cada bloco alimenta a taxa
+// adaptativa e passa pelo filtro; a tela mostra a saída filtrada mais recente
+esp_err_t SystemController::consume_captured_samples() {
+    SMP3011Driver::Sample samples[32];
+    int32_t raw_block[32];
+    SMP3011Driver::CaptureRing& ring = smp3011_->get_capture_ring();
+    size_t total = 0;
+    size_t count;
+
+    while ((count = ring.pop_batch(samples, sizeof(samples) / sizeof(samples[0]))) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            snapshot_engine_.provide_tire_sample(samples[i]);
+            record_tire_sample(samples[i].timestamp_us, samples[i].pressure_kilopascal);
+            raw_block[i] = (int32_t)samples[i].raw_pressure;
+        }
+
+        size_t filtered_count = tire_filter_.process(raw_block, count);
+        if (filtered_count > 0) {
+            filtered_tire_pressure_ = smp3011_->convert_raw_to_pressure((uint32_t)raw_block[filtered_count - 1]);
+        }
+        total += count;
+    }
+
+    ESP_LOGD(TAG, "%u amostras do SMP3011 consumidas", (unsigned)total);
+    return (total > 0) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+void SystemController::configure_sample_rate(const AdaptiveRateController::Config& config) {
+    rate_controller_.configure(config);
+    apply_sample_rate();
+}
+
+void SystemController::record_tire_sample(int64_t timestamp_us, float pressure_kpa) {
+    if (rate_controller_.add_sample(timestamp_us, pressure_kpa)) {
+        AdaptiveRateController::Stats stats = rate_controller_.get_stats();
+        ESP_LOGI(TAG, "Taxa do pneu: %.1f Hz (inclinação %.2f kPa/s, desvio %.2f kPa)",
+                 stats.current_rate_hz, stats.slope_kpa_per_s, stats.deviation_kpa);
+        apply_sample_rate();
+    }
+}
+
+// Com a captura contínua ativa a taxa vai direto para o timer do driver; sem ela
+// vale pelo intervalo do ciclo em process_events
+void SystemController::apply_sample_rate() {
+    if (smp3011_->is_capture_running()) {
+        uint64_t period_us = (uint64_t)(1000000.0f / rate_controller_.get_current_rate_hz());
+        esp_err_t result = smp3011_->set_capture_period_us(period_us);
+        if (result != ESP_OK) {
+            ESP_LOGW(TAG, "Falha ao ajustar período da captura: %s", esp_err_to_name(result));
+        }
     }
+}
 
-    ESP_LOGD(TAG, "Leituras: Temp=%.1fC, Atm=%.1fhPa, Pneu=%.1fkPa", 
-             current_temperature_, current_atmospheric_pressure_, current_tire_pressure_);
+uint32_t SystemController::get_sensor_read_interval_ms() const {
+    uint32_t interval_ms = rate_controller_.get_sample_interval_ms();
+    return (interval_ms < MIN_SENSOR_READ_INTERVAL_MS) ? MIN_SENSOR_READ_INTERVAL_MS : interval_ms;
 }
 
 void SystemController::update_display() {
@@ -134,9 +297,15 @@ void SystemController::update_display() {
             case OperationMode::QUICK_READ:
             case OperationMode::DETAILED_READ:
             case OperationMode::SETTINGS:
-                display_->display_sensor_readings(current_temperature_, 
-                                                 current_atmospheric_pressure_, 
-                                                 current_tire_pressure_);
+                // A tela só redesenha e envia os campos cujo valor exibido mudou
+                display_->display_sensor_readings(current_snapshot_.temperature_celsius, 
+                                                 current_snapshot_.atmospheric_hectopascal, 
+                                                 get_displayed_tire_pressure(), get_status_icon());
+                break;
+            case OperationMode::PRESSURE_TREND:
+                // Tendência da pressão: uma coluna por leitura, varrida da esquerda para a direita
+                display_->set_trend_column_period_ms(get_sensor_read_interval_ms());
+                display_->display_trend(get_displayed_tire_pressure());
                 break;
             default:
                 break;
@@ -166,6 +335,6 @@ void SystemController::apply_calibration(float offset) {
 }
 
 void SystemController::show_current_mode() {
-    const char* mode_names[] = {"LEITURA RAPIDA", "LEITURA DETALHADA", "CALIBRACAO", "CONFIGURACOES"};
+    const char* mode_names[] = {"LEITURA RAPIDA", "LEITURA DETALHADA", "CALIBRACAO", "CONFIGURACOES", "TENDENCIA"};
     ESP_LOGI(TAG, "Modo atual: %s", mode_names[static_cast<int>(current_mode_)]);
 }
\ No newline at end of file
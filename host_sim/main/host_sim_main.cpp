@@ -0,0 +1,759 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "nvs_flash.h"
+
+#include "i2c_manager.hpp"
+#include "simulated_i2c_bus.hpp"
+#include "sim_bmp280.hpp"
+#include "sim_smp3011.hpp"
+#include "sim_ssd1306.hpp"
+#include "sim_tca9548a.hpp"
+#include "bmp280_driver.hpp"
+#include "bmp280_compensation_benchmark.hpp"
+#include "smp3011_driver.hpp"
+#include "oled_display.hpp"
+#include "text_render_benchmark.hpp"
+#include "adaptive_rate_controller.hpp"
+#include "pressure_filter_benchmark.hpp"
+#include "snapshot_engine.hpp"
+#include "i2c_mux.hpp"
+#include "multi_tire_scheduler.hpp"
+
+static const char *TAG = "HostSim";
+
+constexpr uint8_t OLED_I2C_ADDRESS = 0x3C;
+constexpr uint8_t BMP280_I2C_ADDRESS = 0x76;
+constexpr uint8_t SMP3011_I2C_ADDRESS = 0x78;
+constexpr uint32_t SIM_CLOCK_SPEED = 400000;
+// Overhead típico de driver + ISR por transação no ESP32
+constexpr uint32_t SIM_TRANSACTION_OVERHEAD_NS = 60000;
+
+// Barramentos e modelos simulados
+static SimulatedI2CBus display_bus;
+static SimulatedI2CBus sensor_bus;
+static SimSSD1306 simulated_display(OLED_I2C_ADDRESS);
+static SimBMP280 simulated_bmp280(BMP280_I2C_ADDRESS);
+static SimSMP3011 simulated_smp3011(SMP3011_I2C_ADDRESS);
+
+// Mesma topologia do firmware
+static I2CManager i2c0_bus(I2C_NUM_0);
+static I2CManager i2c1_bus(I2C_NUM_1);
+static OLEDDisplay status_display(&i2c0_bus, OLED_I2C_ADDRESS);
+static BMP280Driver environmental_sensor(&i2c1_bus, BMP280_I2C_ADDRESS);
+static SMP3011Driver tire_pressure_sensor(&i2c1_bus, SMP3011_I2C_ADDRESS);
+
+static void report_operation(const char *operation, SimulatedI2CBus &bus, uint32_t iterations) {
+    SimulatedI2CBus::BusStats stats = bus.get_stats();
+    ESP_LOGI(TAG, "%-28s %6.1f transações, %7.1f bytes, %9.1f us de fio por operação",
+             operation, (double)stats.transactions / iterations, (double)stats.bytes_transferred / iterations,
+             (double)stats.wire_time_ns / 1000.0 / iterations);
+    bus.reset_stats();
+}
+
+static void run_display_scenarios() {
+    constexpr uint32_t iterations = 10;
+
+    display_bus.reset_stats();
+    status_display.initialize_display();
+    report_operation("OLED initialize_display", display_bus, 1);
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        status_display.clear_display();
+    }
+    report_operation("OLED clear_display", display_bus, iterations);
+
+    status_display.reset_flush_stats();
+    for (uint32_t i = 0; i < iterations; i++) {
+        status_display.display_sensor_readings(25.0f + i, 1013.0f, 220.0f);
+    }
+    report_operation("OLED display_sensor_readings", display_bus, iterations);
+
+    OLEDDisplay::FlushStats flush_stats = status_display.get_flush_stats();
+    ESP_LOGI(TAG, "OLED flush: %lu flushes (%lu sem mudança), %lu janelas, %lu bytes de pixel",
+             (unsigned long)flush_stats.flushes, (unsigned long)flush_stats.empty_flushes,
+             (unsigned long)flush_stats.windows, (unsigned long)flush_stats.data_bytes);
+    simulated_display.dump_ascii();
+
+    // Pressão estável com ruído abaixo da resolução de cada campo: nenhum valor
+    // formatado muda e nada vai para o barramento. Depois o mesmo ruído em cima da
+    // fronteira de arredondamento (2,205 bar, 1013,25 hPa): sem histerese a tela
+    // acompanha cada troca do valor formatado.
+    constexpr uint32_t steady_iterations = 200;
+    static const struct {
+        float temperature_celsius;
+        float atmospheric_hpa;
+        float tire_kpa;
+        const char *name;
+    } steady_cases[] = {
+        {25.0f, 1013.2f, 220.0f, "OLED leituras estáveis"},
+        {25.0f, 1013.25f, 220.5f, "OLED leituras na fronteira"},
+    };
+    for (const auto &steady : steady_cases) {
+        uint32_t noise_state = 0xACE1u;
+        status_display.display_sensor_readings(steady.temperature_celsius, steady.atmospheric_hpa, steady.tire_kpa);
+        display_bus.reset_stats();
+        status_display.reset_flush_stats();
+        for (uint32_t i = 0; i < steady_iterations; i++) {
+            noise_state = noise_state * 1664525u + 1013904223u;
+            float noise = (float)((int32_t)((noise_state >> 8) % 61) - 30) / 100.0f;
+            status_display.display_sensor_readings(steady.temperature_celsius + noise * 0.1f,
+                                                   steady.atmospheric_hpa + noise * 0.1f,
+                                                   steady.tire_kpa + noise * 0.6f);
+        }
+        flush_stats = status_display.get_flush_stats();
+        ESP_LOGI(TAG, "%s: %lu quadros entregues em %lu atualizações", steady.name,
+                 (unsigned long)flush_stats.presents, (unsigned long)steady_iterations);
+        report_operation(steady.name, display_bus, steady_iterations);
+    }
+}
+
+// Tempo preso em display_sensor_readings() com o envio na hora e com a task de
+// flush, num barramento em tempo real: com a task só sobra o desenho e a cópia.
+// Atualizações mais rápidas que o barramento se fundem num quadro só.
+static void run_display_flush_task_scenario() {
+    constexpr uint32_t iterations = 20;
+    display_bus.set_realtime(true);
+
+    for (int with_task = 0; with_task <= 1; with_task++) {
+        if (with_task) {
+            status_display.start_flush_task(1, 4096);
+        }
+        status_display.reset_flush_stats();
+
+        int64_t max_us = 0;
+        int64_t total_us = 0;
+        for (uint32_t i = 0; i < iterations; i++) {
+            int64_t start_us = esp_timer_get_time();
+            status_display.display_sensor_readings(20.0f + i * 0.5f, 1013.0f + i, 200.0f + with_task * 100.0f + i * 3.0f);
+            int64_t elapsed_us = esp_timer_get_time() - start_us;
+            total_us += elapsed_us;
+            max_us = (elapsed_us > max_us) ? elapsed_us : max_us;
+            // Metade das atualizações em rajada, metade espaçadas de um tick
+            if (i % 2 == 1) {
+                vTaskDelay(1);
+            }
+        }
+        while (status_display.is_flush_pending()) {
+            vTaskDelay(1);
+        }
+
+        OLEDDisplay::FlushStats stats = status_display.get_flush_stats();
+        ESP_LOGI(TAG, "OLED %-16s %7.1f us médio, %7.1f us máximo por atualização; %lu quadros, %lu fundidos, %lu bytes",
+                 with_task ? "com task" : "envio na hora", (double)total_us / iterations, (double)max_us,
+                 (unsigned long)stats.presents, (unsigned long)stats.merged_frames, (unsigned long)stats.data_bytes);
+        report_operation(with_task ? "OLED leituras (task)" : "OLED leituras (na hora)", display_bus, iterations);
+    }
+
+    status_display.stop_flush_task();
+    display_bus.set_realtime(false);
+}
+
+// Tela de tendência num barramento em tempo real, uma coluna por amostra e mais
+// amostras que colunas (o cursor dá a volta). Cada amostra só pode mandar a coluna
+// nova, a lacuna e o valor do cabeçalho; o scroll do painel nunca liga, e o painel
+// tem que bater com o framebuffer na tendência e na saída para a tela de leituras.
+static void run_trend_sweep_scenario() {
+    constexpr uint32_t samples = 150;
+    constexpr uint32_t graph_bytes = 6 * 128;
+    display_bus.set_realtime(true);
+
+    status_display.set_trend_column_period_ms(pdTICKS_TO_MS(2));
+    status_display.display_trend(220.0f);
+    while (status_display.is_flush_pending()) {
+        vTaskDelay(1);
+    }
+    display_bus.reset_stats();
+    simulated_display.reset_stats();
+    status_display.reset_flush_stats();
+
+    for (uint32_t i = 0; i < samples; i++) {
+        vTaskDelay(2);
+        status_display.display_trend(220.0f + 12.0f * sinf((float)i * 0.08f));
+    }
+    while (status_display.is_flush_pending()) {
+        vTaskDelay(1);
+    }
+
+    OLEDDisplay::FlushStats flush_stats = status_display.get_flush_stats();
+    SimSSD1306::DisplayStats display_stats = simulated_display.get_stats();
+    ESP_LOGI(TAG, "OLED tendência: coluna de %lu us, %.1f bytes de pixel por amostra (gráfico inteiro: %lu)",
+             (unsigned long)status_display.get_trend_column_period_us(), (double)flush_stats.data_bytes / samples,
+             (unsigned long)graph_bytes);
+    ESP_LOGI(TAG, "OLED tendência: %lu janelas, %lu passos de scroll, %lu violações",
+             (unsigned long)flush_stats.windows, (unsigned long)display_stats.scroll_steps,
+             (unsigned long)display_stats.scroll_violations);
+    report_operation("OLED display_trend", display_bus, samples);
+    simulated_display.dump_ascii();
+    bool trend_matches = memcmp(simulated_display.get_framebuffer(), status_display.get_framebuffer(), graph_bytes + 2 * 128) == 0;
+
+    status_display.display_sensor_readings(25.0f, 1013.0f, 220.0f);
+    while (status_display.is_flush_pending()) {
+        vTaskDelay(1);
+    }
+    bool panel_matches = memcmp(simulated_display.get_framebuffer(), status_display.get_framebuffer(), graph_bytes + 2 * 128) == 0;
+    ESP_LOGI(TAG, "OLED tendência: painel %s framebuffer; na saída, painel %s framebuffer",
+             trend_matches ? "igual ao" : "DIFERENTE do", panel_matches ? "igual ao" : "DIFERENTE do");
+    display_bus.set_realtime(false);
+}
+
+// Só CPU durante as medidas; no fim a tela é limpa e as mesmas leituras de antes
+// precisam voltar inteiras, não só os campos que mudaram
+static void run_text_benchmark_scenario() {
+    TextRenderBenchmark benchmark(&status_display);
+    benchmark.run_standard_suite();
+
+    status_display.display_sensor_readings(25.0f, 1013.0f, 220.0f);
+    while (status_display.is_flush_pending()) {
+        vTaskDelay(1);
+    }
+    bool panel_matches = memcmp(simulated_display.get_framebuffer(), status_display.get_framebuffer(),
+                                8 * 128) == 0;
+    ESP_LOGI(TAG, "Leituras depois do benchmark de texto: painel %s framebuffer",
+             panel_matches ? "igual ao" : "DIFERENTE do");
+}
+
+static void run_sensor_scenarios() {
+    constexpr uint32_t iterations = 20;
+    float temperature, atmospheric_pressure, tire_pressure;
+
+    sensor_bus.reset_stats();
+    environmental_sensor.initialize_sensor();
+    report_operation("BMP280 initialize_sensor", sensor_bus, 1);
+
+    // Modo normal: leituras não esperam conversão (cenário comparável ao ciclo sobreposto)
+    environmental_sensor.set_profile(BMP280Driver::MeasurementProfile::HIGH_RESOLUTION);
+    vTaskDelay(pdMS_TO_TICKS(environmental_sensor.get_measurement_time_us() / 1000) + 1);
+    sensor_bus.reset_stats();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        environmental_sensor.read_temperature_and_pressure(&temperature, &atmospheric_pressure);
+    }
+    report_operation("BMP280 leitura", sensor_bus, iterations);
+    ESP_LOGI(TAG, "BMP280: %.2f C, %.2f hPa", temperature, atmospheric_pressure);
+
+    // O modelo implementa os bits de status: burst com verificação
+    tire_pressure_sensor.set_status_check(true);
+    tire_pressure_sensor.initialize_sensor();
+    report_operation("SMP3011 initialize_sensor", sensor_bus, 1);
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        tire_pressure_sensor.read_pressure(&tire_pressure);
+    }
+    report_operation("SMP3011 leitura", sensor_bus, iterations);
+    const SMP3011Driver::Sample &sample = tire_pressure_sensor.get_last_sample();
+    ESP_LOGI(TAG, "SMP3011: %.2f kPa (raw %lu, status 0x%02X, capturada em %lld us)", tire_pressure,
+             (unsigned long)sample.raw_pressure, sample.status, sample.timestamp_us);
+
+    // Ciclo sobreposto: conversão do SMP3011 em paralelo com a leitura do BMP280.
+    // Mede o tempo em que a task ficou presa dentro dos drivers.
+    int64_t blocking_us = 0;
+    int64_t overlapped_us = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        int64_t start_us = esp_timer_get_time();
+        environmental_sensor.read_temperature_and_pressure(&temperature, &atmospheric_pressure);
+        tire_pressure_sensor.read_pressure(&tire_pressure);
+        blocking_us += esp_timer_get_time() - start_us;
+
+        start_us = esp_timer_get_time();
+        tire_pressure_sensor.start_measurement();
+        environmental_sensor.read_temperature_and_pressure(&temperature, &atmospheric_pressure);
+        overlapped_us += esp_timer_get_time() - start_us;
+
+        vTaskDelay(pdMS_TO_TICKS(tire_pressure_sensor.get_ready_time_hint_ms()) + 1);
+        start_us = esp_timer_get_time();
+        tire_pressure_sensor.fetch_result(&tire_pressure);
+        overlapped_us += esp_timer_get_time() - start_us;
+    }
+    ESP_LOGI(TAG, "Ciclo de sensores: %lld us bloqueado (sequencial) vs %lld us (duas fases)",
+             blocking_us / iterations, overlapped_us / iterations);
+    sensor_bus.reset_stats();
+}
+
+// Custo de cada perfil do BMP280: transações, tempo preso na leitura e conversões
+// disparadas (no modo normal o sensor converte sozinho)
+static void run_bmp280_profile_scenario() {
+    constexpr uint32_t iterations = 10;
+    static const struct {
+        BMP280Driver::MeasurementProfile profile;
+        const char *name;
+    } profiles[] = {
+        {BMP280Driver::MeasurementProfile::LOW_POWER, "BMP280 perfil baixo consumo"},
+        {BMP280Driver::MeasurementProfile::BALANCED, "BMP280 perfil equilibrado"},
+        {BMP280Driver::MeasurementProfile::HIGH_RESOLUTION, "BMP280 perfil alta resolução"},
+        {BMP280Driver::MeasurementProfile::HIGH_RATE, "BMP280 perfil alta taxa"},
+    };
+    float temperature, atmospheric_pressure;
+
+    for (const auto &entry : profiles) {
+        environmental_sensor.set_profile(entry.profile);
+        uint32_t conversions_before = simulated_bmp280.get_conversions_started();
+        sensor_bus.reset_stats();
+
+        int64_t blocking_us = 0;
+        esp_err_t result = ESP_OK;
+        for (uint32_t i = 0; i < iterations; i++) {
+            int64_t start_us = esp_timer_get_time();
+            esp_err_t read_result = environmental_sensor.read_temperature_and_pressure(&temperature,
+                                                                                       &atmospheric_pressure);
+            blocking_us += esp_timer_get_time() - start_us;
+            result = (read_result != ESP_OK) ? read_result : result;
+        }
+
+        ESP_LOGI(TAG, "%s: %s, %.2f hPa, %lld us por leitura, conversão máx %lu us, %lu conversões forçadas",
+                 entry.name, esp_err_to_name(result), atmospheric_pressure, blocking_us / iterations,
+                 (unsigned long)environmental_sensor.get_measurement_time_us(),
+                 (unsigned long)(simulated_bmp280.get_conversions_started() - conversions_before));
+        report_operation(entry.name, sensor_bus, iterations);
+    }
+
+    environmental_sensor.set_profile(BMP280Driver::MeasurementProfile::HIGH_RESOLUTION);
+    sensor_bus.reset_stats();
+}
+
+// Leitura sequencial (uma conversão depois da outra) contra o snapshot com as
+// conversões sobrepostas, em cada modo do BMP280
+static void run_snapshot_scenario() {
+    constexpr uint32_t iterations = 10;
+    static const struct {
+        BMP280Driver::MeasurementProfile profile;
+        const char *name;
+    } profiles[] = {
+        {BMP280Driver::MeasurementProfile::LOW_POWER, "forçado"},
+        {BMP280Driver::MeasurementProfile::HIGH_RESOLUTION, "normal"},
+    };
+    SnapshotEngine snapshot_engine(&environmental_sensor, &tire_pressure_sensor);
+    float temperature, atmospheric_pressure, tire_pressure;
+
+    for (const auto &entry : profiles) {
+        environmental_sensor.set_profile(entry.profile);
+        vTaskDelay(pdMS_TO_TICKS(environmental_sensor.get_measurement_time_us() / 1000) + 1);
+
+        int64_t sequential_us = 0;
+        for (uint32_t i = 0; i < iterations; i++) {
+            int64_t start_us = esp_timer_get_time();
+            environmental_sensor.read_temperature_and_pressure(&temperature, &atmospheric_pressure);
+            tire_pressure_sensor.read_pressure(&tire_pressure);
+            sequential_us += esp_timer_get_time() - start_us;
+        }
+
+        SnapshotEngine::Snapshot snapshot = {};
+        esp_err_t result = ESP_OK;
+        snapshot_engine.reset_stats();
+        for (uint32_t i = 0; i < iterations; i++) {
+            esp_err_t acquire_result = snapshot_engine.acquire(&snapshot);
+            result = (acquire_result != ESP_OK) ? acquire_result : result;
+        }
+
+        SnapshotEngine::Stats stats = snapshot_engine.get_stats();
+        ESP_LOGI(TAG, "Snapshot (BMP280 %s): %s, %lld us sequencial vs %lu us sobreposto, "
+                 "defasagem média %lld us, máx %lld us (limite %lld us), %lu parciais",
+                 entry.name, esp_err_to_name(result), sequential_us / iterations,
+                 (unsigned long)stats.mean_acquisition_us, stats.mean_skew_us, stats.max_skew_us,
+                 stats.max_skew_bound_us, (unsigned long)stats.partial_snapshots);
+        ESP_LOGI(TAG, "Snapshot %lu: %.2f hPa, pneu %.2f kPa abs / %.2f kPa manométrica",
+                 (unsigned long)snapshot.sequence, snapshot.atmospheric_hectopascal,
+                 snapshot.tire_absolute_kilopascal, snapshot.tire_gauge_kilopascal);
+    }
+
+    environmental_sensor.set_profile(BMP280Driver::MeasurementProfile::HIGH_RESOLUTION);
+    sensor_bus.reset_stats();
+}
+
+// Escalonamento com vários pneus: até 18 SMP3011 (todos em 0x78) atrás de três
+// TCA9548A num barramento próprio em tempo real, cada um num barramento virtual.
+// Compara a leitura sequencial (dispara, espera, lê um por vez) com o ciclo do
+// MultiTireScheduler, que sobrepõe as conversões. No fim um pneu morto: o disjuntor
+// dele abre no barramento virtual e os demais seguem lendo.
+static void run_multi_tire_scaling_scenario() {
+    constexpr size_t max_tires = 18;
+    constexpr uint32_t cycles = 5;
+    constexpr uint32_t conversion_time_us = 10000;
+    static const uint8_t mux_addresses[] = {0x70, 0x71, 0x72};
+    static const size_t tire_counts[] = {1, 2, 4, 8, 12, 18};
+    constexpr size_t mux_count = sizeof(mux_addresses) / sizeof(mux_addresses[0]);
+
+    static SimulatedI2CBus tire_bus;
+    static SimTCA9548A *simulated_muxes[mux_count];
+    static SimSMP3011 *simulated_tires[max_tires];
+    static I2CManager tire_parent_bus(I2C_NUM_1);
+    static I2CMux tire_mux(&tire_parent_bus, mux_addresses, mux_count);
+    static I2CMuxChannel *tire_channels[max_tires];
+    static I2CManager *tire_virtual_buses[max_tires];
+    static SMP3011Driver *tire_sensors[max_tires];
+
+    tire_bus.set_transaction_overhead_ns(SIM_TRANSACTION_OVERHEAD_NS);
+    tire_bus.set_realtime(true);
+    for (size_t i = 0; i < mux_count; i++) {
+        simulated_muxes[i] = new SimTCA9548A(mux_addresses[i]);
+        tire_bus.attach_device(simulated_muxes[i]);
+    }
+    tire_parent_bus.attach_backend(&tire_bus);
+    tire_parent_bus.initialize(GPIO_NUM_NC, GPIO_NUM_NC, SIM_CLOCK_SPEED);
+    tire_mux.initialize();
+
+    for (size_t i = 0; i < max_tires; i++) {
+        size_t mux_index = i / I2CMux::CHANNELS_PER_MUX;
+        simulated_tires[i] = new SimSMP3011(SMP3011_I2C_ADDRESS);
+        simulated_tires[i]->set_raw_pressure(167772 + 1000 * i);
+        simulated_tires[i]->set_conversion_time_us(conversion_time_us);
+        simulated_muxes[mux_index]->attach_downstream(i % I2CMux::CHANNELS_PER_MUX, simulated_tires[i]);
+
+        tire_channels[i] = new I2CMuxChannel(&tire_mux, (uint8_t)i);
+        tire_virtual_buses[i] = new I2CManager(I2C_NUM_1);
+        tire_virtual_buses[i]->attach_backend(tire_channels[i]);
+        tire_virtual_buses[i]->initialize(GPIO_NUM_NC, GPIO_NUM_NC, SIM_CLOCK_SPEED);
+
+        tire_sensors[i] = new SMP3011Driver(tire_virtual_buses[i], SMP3011_I2C_ADDRESS);
+        tire_sensors[i]->initialize_sensor();
+        tire_sensors[i]->set_conversion_time_us(conversion_time_us);
+    }
+
+    for (size_t tire_count : tire_counts) {
+        float pressure;
+        int64_t start_us = esp_timer_get_time();
+        for (uint32_t cycle = 0; cycle < cycles; cycle++) {
+            for (size_t i = 0; i < tire_count; i++) {
+                tire_sensors[i]->read_pressure(&pressure);
+            }
+        }
+        int64_t sequential_us = (esp_timer_get_time() - start_us) / cycles;
+
+        MultiTireScheduler scheduler;
+        for (size_t i = 0; i < tire_count; i++) {
+            scheduler.add_sensor(tire_sensors[i]);
+        }
+        tire_bus.reset_stats();
+        tire_mux.reset_stats();
+        start_us = esp_timer_get_time();
+        for (uint32_t cycle = 0; cycle < cycles; cycle++) {
+            scheduler.run_cycle();
+        }
+        int64_t pipelined_us = (esp_timer_get_time() - start_us) / cycles;
+
+        MultiTireScheduler::Stats stats = scheduler.get_stats();
+        SimulatedI2CBus::BusStats bus_stats = tire_bus.get_stats();
+        I2CMux::Stats mux_stats = tire_mux.get_stats();
+        ESP_LOGI(TAG, "%2u pneus: %6lld us sequencial, %6lld us escalonado (máx %lu), %5.0f us de fio, "
+                 "%4.1f trocas de canal, %lu erros, %lu colisões",
+                 (unsigned)tire_count, sequential_us, pipelined_us, (unsigned long)stats.max_cycle_us,
+                 (double)bus_stats.wire_time_ns / 1000.0 / cycles,
+                 (double)mux_stats.channel_switches / cycles, (unsigned long)stats.errors,
+                 (unsigned long)bus_stats.address_collisions);
+    }
+
+    float pressure;
+    simulated_tires[0]->inject_next_failures(1000, ESP_FAIL);
+    for (uint32_t cycle = 0; cycle < 10; cycle++) {
+        tire_sensors[0]->read_pressure(&pressure);
+    }
+    esp_err_t healthy_result = tire_sensors[1]->read_pressure(&pressure);
+    I2CManager::DeviceStats parent_stats = {};
+    esp_err_t parent_entry = tire_parent_bus.get_device_stats(SMP3011_I2C_ADDRESS, &parent_stats);
+    ESP_LOGI(TAG, "Pneu 0 morto: isolado %s, pneu 1 %s, registro do pai para 0x%02X: %s",
+             tire_virtual_buses[0]->is_device_isolated(SMP3011_I2C_ADDRESS) ? "sim" : "não",
+             esp_err_to_name(healthy_result), SMP3011_I2C_ADDRESS,
+             (parent_entry == ESP_OK) ? "presente" : "ausente");
+    simulated_tires[0]->clear_faults();
+
+    ESP_LOGI(TAG, "Pneu %u: %.2f kPa (raw %lu)", (unsigned)(max_tires - 1),
+             tire_sensors[max_tires - 1]->get_last_sample().pressure_kilopascal,
+             (unsigned long)tire_sensors[max_tires - 1]->get_last_sample().raw_pressure);
+}
+
+static void run_capture_scenario() {
+    constexpr uint32_t capture_rate_hz = 200;
+    constexpr uint32_t capture_duration_ms = 500;
+    SMP3011Driver::Sample samples[SMP3011Driver::CAPTURE_RING_CAPACITY];
+
+    // Conversão do modelo é 10 ms; a taxa pedida é limitada pelo driver
+    simulated_smp3011.set_noise_amplitude(200);
+    tire_pressure_sensor.set_conversion_time_us(10000);
+    tire_pressure_sensor.start_continuous_capture(capture_rate_hz, 5, 4096);
+    vTaskDelay(pdMS_TO_TICKS(capture_duration_ms));
+    tire_pressure_sensor.stop_continuous_capture();
+
+    size_t count = tire_pressure_sensor.get_capture_ring().pop_batch(samples, SMP3011Driver::CAPTURE_RING_CAPACITY);
+    int64_t max_interval_us = 0;
+    for (size_t i = 1; i < count; i++) {
+        int64_t interval_us = samples[i].timestamp_us - samples[i - 1].timestamp_us;
+        if (interval_us > max_interval_us) {
+            max_interval_us = interval_us;
+        }
+    }
+
+    SMP3011Driver::CaptureStats stats = tire_pressure_sensor.get_capture_stats();
+    ESP_LOGI(TAG, "Captura contínua: %u amostras em %lu ms (%lu Hz efetivos), maior intervalo %lld us, "
+             "%lu erros, %lu períodos perdidos, %lu overruns",
+             (unsigned)count, (unsigned long)capture_duration_ms, (unsigned long)(1000000 / stats.period_us),
+             max_interval_us, (unsigned long)stats.read_errors, (unsigned long)stats.missed_ticks,
+             (unsigned long)stats.ring_overruns);
+    report_operation("SMP3011 captura contínua", sensor_bus, (count > 0) ? count : 1);
+
+    simulated_smp3011.set_noise_amplitude(0);
+    tire_pressure_sensor.set_conversion_time_us(0);
+}
+
+// Perfil de pressão em tempo simulado: parado, enchendo a 5 kPa/s e parado de novo.
+// Cada amostra avança o relógio pelo intervalo que o controlador pede.
+static void run_adaptive_rate_scenario() {
+    constexpr int64_t static_phase_us = 20000000;
+    constexpr int64_t inflation_phase_us = 10000000;
+    constexpr int64_t profile_duration_us = 60000000;
+    constexpr float base_pressure_kpa = 200.0f;
+    constexpr float inflation_rate_kpa_per_s = 5.0f;
+    constexpr float noise_amplitude_kpa = 0.3f;
+
+    AdaptiveRateController controller;
+    uint32_t noise_state = 1;
+    int64_t now_us = 0;
+    int64_t active_since_us = -1;
+
+    while (now_us < profile_duration_us) {
+        float pressure_kpa = base_pressure_kpa;
+        if (now_us >= static_phase_us) {
+            int64_t inflating_us = now_us - static_phase_us;
+            if (inflating_us > inflation_phase_us) {
+                inflating_us = inflation_phase_us;
+            }
+            pressure_kpa += inflation_rate_kpa_per_s * inflating_us / 1000000.0f;
+        }
+        noise_state = noise_state * 1103515245u + 12345u;
+        pressure_kpa += noise_amplitude_kpa * (((noise_state >> 16) & 0x7FFF) / 16383.5f - 1.0f);
+
+        if (controller.add_sample(now_us, pressure_kpa)) {
+            if (controller.is_active() && active_since_us < 0) {
+                active_since_us = now_us;
+            }
+            ESP_LOGI(TAG, "t=%6.2f s: taxa %.2f Hz (%.1f kPa)", now_us / 1000000.0, controller.get_current_rate_hz(),
+                     pressure_kpa);
+        }
+        now_us += (int64_t)(1000000.0f / controller.get_current_rate_hz());
+    }
+
+    AdaptiveRateController::Stats stats = controller.get_stats();
+    ESP_LOGI(TAG, "Taxa adaptativa: enchimento detectado %.2f s após o início, %lu amostras, %lu economizadas "
+             "contra taxa fixa de %.0f Hz, %lu ativações",
+             (active_since_us - static_phase_us) / 1000000.0, (unsigned long)stats.samples_taken,
+             (unsigned long)stats.samples_saved, AdaptiveRateController::DEFAULT_CONFIG.max_rate_hz,
+             (unsigned long)stats.activations);
+}
+
+// Calibração lida do modelo (coeficientes do datasheet)
+static void run_compensation_benchmark_scenario() {
+    BMP280CompensationBenchmark benchmark(environmental_sensor.get_calibration());
+    benchmark.run_all();
+
+    // Mesmo sensor com o backend float escolhido no tipo do driver
+    BasicBMP280Driver<BMP280CompensationFloat> float_sensor(&i2c1_bus, BMP280_I2C_ADDRESS);
+    float temperature_default = 0, pressure_default = 0, temperature_float = 0, pressure_float = 0;
+    if (environmental_sensor.read_temperature_and_pressure(&temperature_default, &pressure_default) == ESP_OK &&
+        float_sensor.initialize_sensor() == ESP_OK &&
+        float_sensor.read_temperature_and_pressure(&temperature_float, &pressure_float) == ESP_OK) {
+        ESP_LOGI(TAG, "BMP280 %s: %.2f hPa, %s: %.2f hPa", BMP280Driver::PressureCompensation::NAME,
+                 (double)pressure_default, BMP280CompensationFloat::NAME, (double)pressure_float);
+    }
+    // A inicialização do segundo driver resetou o sensor: devolve a configuração ao principal
+    environmental_sensor.initialize_sensor();
+}
+
+// Maior desvio da tabela contra a curva exata, em passos de 7 contagens mais os
+// próprios pontos da curva
+static float calibration_max_error(const PressureCalibration& calibration, const PressureCalibration::Curve& curve) {
+    float max_error_kpa = 0;
+    for (uint32_t raw = 0; raw < (1u << PressureCalibration::RAW_BITS) + curve.point_count; raw += 7) {
+        uint32_t counts = (raw < (1u << PressureCalibration::RAW_BITS))
+                              ? raw
+                              : curve.points[raw - (1u << PressureCalibration::RAW_BITS)].raw_counts;
+        float error = calibration.convert(counts) - PressureCalibration::evaluate_curve(curve, (float)counts);
+        error = (error < 0) ? -error : error;
+        max_error_kpa = (error > max_error_kpa) ? error : max_error_kpa;
+    }
+    return max_error_kpa;
+}
+
+// Curva de 4 pontos salva no NVS: erro da tabela contra a curva exata e custo da
+// conversão por amostra. Depois uma curva com pontos fora das fronteiras dos
+// segmentos e uma com dois pontos no mesmo segmento, que precisa ser rejeitada
+static void run_calibration_scenario() {
+    PressureCalibration::Curve curve = {};
+    curve.version = PressureCalibration::CURVE_VERSION;
+    curve.point_count = 4;
+    curve.points[0] = {0, 0.0f};
+    curve.points[1] = {131072, 240.0f};
+    curve.points[2] = {262144, 500.0f};
+    curve.points[3] = {524287, 1000.0f};
+    tire_pressure_sensor.set_calibration_curve(curve, true);
+
+    const PressureCalibration& calibration = tire_pressure_sensor.get_calibration();
+    volatile float sink = 0;
+    int64_t start_us = esp_timer_get_time();
+    for (uint32_t raw = 0; raw < (1u << PressureCalibration::RAW_BITS); raw += 7) {
+        sink = calibration.convert(raw);
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start_us;
+    float max_error_kpa = calibration_max_error(calibration, curve);
+    (void)sink;
+
+    float tire_pressure = 0;
+    tire_pressure_sensor.read_pressure(&tire_pressure);
+    ESP_LOGI(TAG, "Calibração de 4 pontos: %.2f kPa, erro máximo da tabela %.4f kPa, %.1f ns por conversão",
+             tire_pressure, max_error_kpa, elapsed_us * 1000.0 / ((1u << PressureCalibration::RAW_BITS) / 7));
+    report_operation("SMP3011 leitura calibrada", sensor_bus, 1);
+
+    PressureCalibration::Curve unaligned = curve;
+    unaligned.points[1] = {100003, 187.5f};
+    unaligned.points[2] = {300001, 530.0f};
+    tire_pressure_sensor.set_calibration_curve(unaligned, false);
+    ESP_LOGI(TAG, "Pontos fora das fronteiras (%lu, %lu): erro máximo da tabela %.4f kPa",
+             (unsigned long)unaligned.points[1].raw_counts, (unsigned long)unaligned.points[2].raw_counts,
+             calibration_max_error(calibration, unaligned));
+
+    PressureCalibration::Curve crowded = unaligned;
+    crowded.points[2].raw_counts = unaligned.points[1].raw_counts + 2000;
+    ESP_LOGI(TAG, "Dois pontos no mesmo segmento: %s",
+             PressureCalibration::is_valid_curve(crowded) ? "aceita (erro)" : "rejeitada");
+
+    tire_pressure_sensor.reset_calibration();
+}
+
+// Mesmo ruído do modelo do SMP3011 na captura contínua, degrau de ~10 kPa
+static void run_filter_benchmark_scenario() {
+    FilterBenchmark benchmark(167772, 200, 5000);
+    benchmark.run_standard_suite();
+}
+
+static void run_fault_injection_scenario() {
+    constexpr uint32_t iterations = 20;
+    uint32_t failures = 0;
+    float tire_pressure;
+
+    // A cada 7 transações o SMP3011 não reconhece o endereço
+    simulated_smp3011.inject_nack_every(7);
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (tire_pressure_sensor.read_pressure(&tire_pressure) != ESP_OK) {
+            failures++;
+        }
+    }
+    simulated_smp3011.clear_faults();
+
+    ESP_LOGI(TAG, "Injeção de NACK: %lu de %lu leituras falharam", (unsigned long)failures, (unsigned long)iterations);
+    report_operation("SMP3011 leitura com NACKs", sensor_bus, iterations);
+}
+
+static void run_clock_fallback_scenario() {
+    constexpr uint32_t iterations = 40;
+    uint32_t failures = 0;
+    float temperature, atmospheric_pressure;
+
+    // Janela curta e período de silêncio curto para caber na simulação
+    i2c1_bus.set_speed_policy({16, 3, 200});
+
+    // Pull-ups fracos: o BMP280 só responde de forma confiável a 100 kHz
+    simulated_bmp280.set_max_clock_speed(100000);
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (environmental_sensor.read_temperature_and_pressure(&temperature, &atmospheric_pressure) != ESP_OK) {
+            failures++;
+        }
+    }
+    ESP_LOGI(TAG, "Fallback de clock: %lu de %lu leituras falharam, barramento a %lu Hz",
+             (unsigned long)failures, (unsigned long)iterations, (unsigned long)i2c1_bus.get_clock_speed());
+    report_operation("BMP280 leitura em fallback", sensor_bus, iterations);
+
+    // Barramento volta a ficar limpo: após o período de silêncio o clock sobe de novo
+    simulated_bmp280.clear_faults();
+    vTaskDelay(pdMS_TO_TICKS(250));
+    for (uint32_t i = 0; i < iterations; i++) {
+        environmental_sensor.read_temperature_and_pressure(&temperature, &atmospheric_pressure);
+    }
+
+    I2CManager::SpeedStats speed = i2c1_bus.get_speed_stats();
+    ESP_LOGI(TAG, "Recuperação: barramento a %lu Hz (alvo %lu Hz), %lu descidas, %lu subidas",
+             (unsigned long)speed.clock_speed, (unsigned long)speed.target_speed,
+             (unsigned long)speed.step_downs, (unsigned long)speed.step_ups);
+    report_operation("BMP280 leitura recuperada", sensor_bus, iterations);
+}
+
+static void run_bus_recovery_scenario() {
+    constexpr uint32_t iterations = 40;
+    uint32_t failures = 0;
+    uint32_t isolated_reads = 0;
+    int64_t max_read_us = 0;
+    float tire_pressure, temperature, atmospheric_pressure;
+
+    // Conector com mau contato: o SMP3011 para de responder por um tempo
+    simulated_smp3011.inject_next_failures(6, ESP_ERR_TIMEOUT);
+    for (uint32_t i = 0; i < iterations; i++) {
+        int64_t start_us = esp_timer_get_time();
+        if (tire_pressure_sensor.read_pressure(&tire_pressure) != ESP_OK) {
+            failures++;
+        }
+        int64_t read_us = esp_timer_get_time() - start_us;
+        if (read_us > max_read_us) {
+            max_read_us = read_us;
+        }
+        if (i2c1_bus.is_device_isolated(SMP3011_I2C_ADDRESS)) {
+            isolated_reads++;
+        }
+        vTaskDelay(pdMS_TO_TICKS(20));
+    }
+    simulated_smp3011.clear_faults();
+
+    ESP_LOGI(TAG, "SMP3011 intermitente: %lu falhas, %lu leituras com circuito aberto, leitura mais lenta %lld us",
+             (unsigned long)failures, (unsigned long)isolated_reads, max_read_us);
+    report_operation("SMP3011 leitura intermitente", sensor_bus, iterations);
+
+    // Escravo segurando SDA: o timeout dispara o bus clear e a leitura seguinte funciona
+    sensor_bus.set_bus_stuck(true);
+    esp_err_t stuck_result = environmental_sensor.read_temperature_and_pressure(&temperature, &atmospheric_pressure);
+    esp_err_t after_clear_result =
+        environmental_sensor.read_temperature_and_pressure(&temperature, &atmospheric_pressure);
+
+    ESP_LOGI(TAG, "SDA presa: leitura %s, após bus clear %s, %lu bus clears", esp_err_to_name(stuck_result),
+             esp_err_to_name(after_clear_result), (unsigned long)i2c1_bus.get_transfer_counters().bus_clears);
+    report_operation("BMP280 leitura com SDA presa", sensor_bus, 2);
+}
+
+extern "C" void app_main(void) {
+    ESP_LOGI(TAG, "=== SIMULAÇÃO DO BARRAMENTO I2C NO HOST ===");
+
+    // Curva de calibração do usuário é persistida no NVS (partição emulada no host)
+    ESP_ERROR_CHECK(nvs_flash_init());
+
+    display_bus.set_transaction_overhead_ns(SIM_TRANSACTION_OVERHEAD_NS);
+    sensor_bus.set_transaction_overhead_ns(SIM_TRANSACTION_OVERHEAD_NS);
+    display_bus.attach_device(&simulated_display);
+    sensor_bus.attach_device(&simulated_bmp280);
+    sensor_bus.attach_device(&simulated_smp3011);
+
+    i2c0_bus.attach_backend(&display_bus);
+    i2c1_bus.attach_backend(&sensor_bus);
+    ESP_ERROR_CHECK(i2c0_bus.initialize(GPIO_NUM_NC, GPIO_NUM_NC, SIM_CLOCK_SPEED));
+    ESP_ERROR_CHECK(i2c1_bus.initialize(GPIO_NUM_NC, GPIO_NUM_NC, SIM_CLOCK_SPEED));
+
+    run_display_scenarios();
+    run_display_flush_task_scenario();
+    run_trend_sweep_scenario();
+    run_text_benchmark_scenario();
+    run_sensor_scenarios();
+    run_bmp280_profile_scenario();
+    run_snapshot_scenario();
+    run_multi_tire_scaling_scenario();
+    run_capture_scenario();
+    run_adaptive_rate_scenario();
+    run_filter_benchmark_scenario();
+    run_calibration_scenario();
+    run_compensation_benchmark_scenario();
+    run_clock_fallback_scenario();
+    run_fault_injection_scenario();
+    run_bus_recovery_scenario();
+
+    i2c0_bus.log_device_stats();
+    i2c1_bus.log_device_stats();
+
+    ESP_LOGI(TAG, "Simulação concluída");
+}
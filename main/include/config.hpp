@@ -12,14 +12,32 @@ constexpr gpio_num_t I2C1_SDA_PIN = GPIO_NUM_33;
 constexpr gpio_num_t I2C1_SCL_PIN = GPIO_NUM_32;
 constexpr uint8_t    BMP280_I2C_ADDRESS = 0x76;
 constexpr uint8_t    SMP3011_I2C_ADDRESS = 0x78;
-#define I2C_CLOCK_SPEED 400000 
+// Vários pneus: SMP3011 extras atrás de multiplexadores TCA9548A no I2C0, um por
+// canal (8 por chip). 0 = só o SMP3011 ligado direto no I2C1. Os sensores dos canais
+// também respondem em 0x78 e, com um canal ligado, colidiriam com o SMP3011 direto;
+// por isso ficam no barramento do display, sem nada em 0x78.
+constexpr uint8_t    TIRE_MUX_ADDRESSES[] = {0x70, 0x71, 0x72};
+constexpr size_t     MULTI_TIRE_COUNT = 0;
+constexpr uint32_t   MULTI_TIRE_SCAN_INTERVAL_MS = 1000;
+// Teto de clock dos barramentos; cada dispositivo pode limitar abaixo disso
+#define I2C_CLOCK_SPEED 400000
 // Configurações do sistema
 constexpr uint32_t SENSOR_READ_INTERVAL_MS = 2000;
+// Captura contínua do SMP3011: taxa máxima da amostragem adaptativa (pressão
+// variando) e taxa em repouso (limitadas pelo tempo de conversão do sensor)
+constexpr uint32_t TIRE_CAPTURE_RATE_HZ = 50;
+constexpr float TIRE_IDLE_RATE_HZ = 0.5f;
+// Mede no alvo o custo por amostra dos filtros de pressão antes do loop principal
+constexpr bool RUN_FILTER_BENCHMARK = false;
+// Mede no alvo os backends de compensação do BMP280 (ciclos e erro contra 64 bits)
+constexpr bool RUN_COMPENSATION_BENCHMARK = false;
+// Mede no alvo o custo por glifo do texto (cópia de colunas contra pixel a pixel)
+constexpr bool RUN_TEXT_BENCHMARK = false;
 
-// ADD THESE BUTTON PIN DEFINITIONS:
-#define BUTTON_UP_PIN   GPIO_NUM_32
-#define BUTTON_DOWN_PIN GPIO_NUM_33  
-#define BUTTON_MODE_PIN GPIO_NUM_25
+// Botões (GPIO 32/33 são usados pelo I2C1)
+#define BUTTON_UP_PIN   GPIO_NUM_12
+#define BUTTON_DOWN_PIN GPIO_NUM_14
+#define BUTTON_MODE_PIN GPIO_NUM_27
 
 // Task stack sizes
 #define SENSOR_TASK_STACK_SIZE  4096
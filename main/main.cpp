@@ -1,8 +1,10 @@
 #include <stdio.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/event_groups.h"
 #include "esp_system.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "nvs_flash.h"
 
 #include "i2c_manager.hpp"
@@ -11,25 +13,88 @@
 #include "oled_display.hpp"
 #include "button_driver.hpp"
 #include "system_controller.hpp"
+#include "bus_topology.hpp"
+#include "i2c_mux.hpp"
+#include "multi_tire_scheduler.hpp"
+#include "pressure_filter_benchmark.hpp"
+#include "bmp280_compensation_benchmark.hpp"
+#include "text_render_benchmark.hpp"
+#include "config.hpp"
 
-// Configurações de hardware
-constexpr gpio_num_t I2C0_SDA_PIN = GPIO_NUM_5;
-constexpr gpio_num_t I2C0_SCL_PIN = GPIO_NUM_4;
-constexpr gpio_num_t I2C1_SDA_PIN = GPIO_NUM_33;
-constexpr gpio_num_t I2C1_SCL_PIN = GPIO_NUM_32;
+// Tasks de trabalho dos barramentos I2C (uma por porta)
+constexpr UBaseType_t I2C_WORKER_PRIORITY = 7;
+constexpr uint32_t I2C_WORKER_STACK_SIZE = 3072;
 
-constexpr uint8_t OLED_I2C_ADDRESS = 0x3C;
-constexpr uint8_t BMP280_I2C_ADDRESS = 0x76;
-constexpr uint8_t SMP3011_I2C_ADDRESS = 0x78;
+// Intervalo de log da telemetria dos barramentos
+constexpr uint32_t I2C_STATS_LOG_INTERVAL_MS = 60000;
 
-constexpr gpio_num_t BUTTON_UP_PIN = GPIO_NUM_12;
-constexpr gpio_num_t BUTTON_DOWN_PIN = GPIO_NUM_14;
-constexpr gpio_num_t BUTTON_MODE_PIN = GPIO_NUM_27;
+// Inicialização do display em paralelo com os sensores
+constexpr uint32_t DISPLAY_INIT_TASK_STACK_SIZE = 4096;
+constexpr UBaseType_t DISPLAY_INIT_TASK_PRIORITY = 5;
+constexpr EventBits_t BOOT_DISPLAY_READY_BIT = (1 << 0);
+
+// Multiplexadores que os pneus usam de fato (8 canais por chip)
+constexpr size_t TIRE_MUX_COUNT =
+    ((MULTI_TIRE_COUNT + I2CMux::CHANNELS_PER_MUX - 1) / I2CMux::CHANNELS_PER_MUX < sizeof(TIRE_MUX_ADDRESSES))
+        ? (MULTI_TIRE_COUNT + I2CMux::CHANNELS_PER_MUX - 1) / I2CMux::CHANNELS_PER_MUX
+        : sizeof(TIRE_MUX_ADDRESSES);
+
+struct ExpectedDevices {
+    uint8_t addresses[1 + sizeof(TIRE_MUX_ADDRESSES)];
+    size_t count;
+};
+
+// Endereços diretos do I2C0: display mais os multiplexadores em uso
+constexpr ExpectedDevices make_i2c0_expected_devices() {
+    ExpectedDevices devices = {{OLED_I2C_ADDRESS}, 1};
+    for (size_t i = 0; i < TIRE_MUX_COUNT; i++) {
+        devices.addresses[devices.count++] = TIRE_MUX_ADDRESSES[i];
+    }
+    return devices;
+}
+
+// Endereço repetido entre os diretos, ou um direto no endereço dos pneus: com um
+// canal ligado os dois responderiam juntos
+constexpr bool has_address_conflict(const ExpectedDevices& devices, uint8_t channel_address) {
+    for (size_t i = 0; i < devices.count; i++) {
+        if (devices.addresses[i] == channel_address) {
+            return true;
+        }
+        for (size_t j = i + 1; j < devices.count; j++) {
+            if (devices.addresses[i] == devices.addresses[j]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Dispositivos esperados em cada barramento (verificados contra o cache em NVS)
+constexpr ExpectedDevices I2C0_EXPECTED_DEVICES = make_i2c0_expected_devices();
+constexpr uint8_t I2C1_EXPECTED_DEVICES[] = {BMP280_I2C_ADDRESS, SMP3011_I2C_ADDRESS};
+static_assert(!has_address_conflict(I2C0_EXPECTED_DEVICES, SMP3011_I2C_ADDRESS),
+              "Endereço do I2C0 em conflito com os multiplexadores ou com os pneus");
+
+// Tempos das fases do boot (µs); cada campo é escrito por uma única task
+struct BootTimings {
+    int64_t nvs_init_us;
+    int64_t i2c0_topology_us;
+    int64_t display_init_us;
+    int64_t i2c1_topology_us;
+    int64_t bmp280_init_us;
+    int64_t smp3011_init_us;
+    int64_t controller_init_us;
+    int64_t display_wait_us;
+    int64_t first_reading_us;
+};
 
 // Instâncias globais
 I2CManager i2c0_bus(I2C_NUM_0);
 I2CManager i2c1_bus(I2C_NUM_1);
 
+BusTopologyCache i2c0_topology(&i2c0_bus, "i2c0");
+BusTopologyCache i2c1_topology(&i2c1_bus, "i2c1");
+
 OLEDDisplay status_display(&i2c0_bus, OLED_I2C_ADDRESS);
 BMP280Driver environmental_sensor(&i2c1_bus, BMP280_I2C_ADDRESS);
 SMP3011Driver tire_pressure_sensor(&i2c1_bus, SMP3011_I2C_ADDRESS);
@@ -38,66 +103,231 @@ ButtonDriver button_control(BUTTON_UP_PIN, BUTTON_DOWN_PIN, BUTTON_MODE_PIN);
 SystemController system_controller(&button_control, &status_display,
                                   &environmental_sensor, &tire_pressure_sensor);
 
-void scan_i2c_bus(I2CManager& i2c_bus, const char* bus_name) {
-    ESP_LOGI("SCAN", "Escaneando barramento %s...", bus_name);
-    uint8_t devices_found_count = 0;
+// Pneus atrás dos multiplexadores (MULTI_TIRE_COUNT > 0), no I2C0: no I2C1 o SMP3011
+// direto responderia junto com o pneu do canal ligado
+I2CMux tire_mux(&i2c0_bus, TIRE_MUX_ADDRESSES, TIRE_MUX_COUNT);
+MultiTireScheduler tire_scheduler;
+
+static BootTimings boot_timings = {};
+static EventGroupHandle_t boot_events = nullptr;
+
+void log_boot_timings() {
+    ESP_LOGI("BOOT", "NVS:              %6lld us", boot_timings.nvs_init_us);
+    ESP_LOGI("BOOT", "I2C0 + topologia: %6lld us (%s)", boot_timings.i2c0_topology_us,
+             i2c0_topology.was_cache_hit() ? "cache" : "scan");
+    ESP_LOGI("BOOT", "Display:          %6lld us", boot_timings.display_init_us);
+    ESP_LOGI("BOOT", "I2C1 + topologia: %6lld us (%s)", boot_timings.i2c1_topology_us,
+             i2c1_topology.was_cache_hit() ? "cache" : "scan");
+    ESP_LOGI("BOOT", "BMP280:           %6lld us", boot_timings.bmp280_init_us);
+    ESP_LOGI("BOOT", "SMP3011:          %6lld us", boot_timings.smp3011_init_us);
+    ESP_LOGI("BOOT", "Controlador:      %6lld us", boot_timings.controller_init_us);
+    ESP_LOGI("BOOT", "Espera display:   %6lld us", boot_timings.display_wait_us);
+    ESP_LOGI("BOOT", "Primeira leitura: %6lld us desde o reset", boot_timings.first_reading_us);
+}
 
-    for (uint8_t device_address = 0x08; device_address <= 0x77; device_address++) {
-        if (i2c_bus.probe_device(device_address) == ESP_OK) {
-            ESP_LOGI("SCAN", "Dispositivo encontrado: 0x%02X", device_address);
-            devices_found_count++;
+// Cada pneu ganha um barramento virtual (um canal do multiplexador) com o
+// SMP3011Driver de sempre; criados uma vez no boot e nunca liberados
+void initialize_multi_tire() {
+    if (MULTI_TIRE_COUNT == 0) {
+        return;
+    }
+    if (tire_mux.initialize() != ESP_OK) {
+        ESP_LOGE("MAIN", "Multiplexadores dos pneus não responderam");
+        return;
+    }
+
+    size_t tire_count = (MULTI_TIRE_COUNT < tire_mux.get_channel_count()) ? MULTI_TIRE_COUNT
+                                                                          : tire_mux.get_channel_count();
+    for (size_t i = 0; i < tire_count; i++) {
+        I2CMuxChannel* channel = new I2CMuxChannel(&tire_mux, (uint8_t)i);
+        I2CManager* virtual_bus = new I2CManager(I2C_NUM_0);
+        virtual_bus->attach_backend(channel);
+        virtual_bus->initialize(GPIO_NUM_NC, GPIO_NUM_NC, I2C_CLOCK_SPEED);
+
+        SMP3011Driver* sensor = new SMP3011Driver(virtual_bus, SMP3011_I2C_ADDRESS);
+        if (sensor->initialize_sensor() != ESP_OK) {
+            ESP_LOGW("MAIN", "Pneu %u (canal %u) não inicializou", (unsigned)i, (unsigned)i);
         }
+        tire_scheduler.add_sensor(sensor);
+    }
+    ESP_LOGI("MAIN", "%u pneus nos multiplexadores", (unsigned)tire_scheduler.get_sensor_count());
+}
+
+// Ciclo dos pneus no loop principal: dispara a cada MULTI_TIRE_SCAN_INTERVAL_MS e
+// recolhe os resultados nas passadas seguintes, sem bloquear
+void service_multi_tire(TickType_t* last_scan) {
+    if (tire_scheduler.get_sensor_count() == 0) {
+        return;
     }
 
-    ESP_LOGI("SCAN", "Scan completo. Dispositivos encontrados: %d", devices_found_count);
+    if (!tire_scheduler.is_cycle_active() &&
+        xTaskGetTickCount() - *last_scan >= pdMS_TO_TICKS(MULTI_TIRE_SCAN_INTERVAL_MS)) {
+        tire_scheduler.start_cycle();
+        *last_scan = xTaskGetTickCount();
+    }
+
+    bool cycle_complete = false;
+    if (tire_scheduler.is_cycle_active() && tire_scheduler.service(&cycle_complete) == ESP_OK && cycle_complete) {
+        for (size_t i = 0; i < tire_scheduler.get_sensor_count(); i++) {
+            const MultiTireScheduler::TireReading& reading = tire_scheduler.get_reading(i);
+            ESP_LOGD("MAIN", "Pneu %u: %.1f kPa (%s)", (unsigned)i, reading.pressure_kilopascal,
+                     esp_err_to_name(reading.result));
+        }
+    }
+}
+
+// I2C0, display e pneus dos multiplexadores inicializam nesta task enquanto
+// app_main cuida do I2C1 e dos sensores
+void display_init_task(void* arg) {
+    int64_t phase_start = esp_timer_get_time();
+
+    if (i2c0_bus.initialize(I2C0_SDA_PIN, I2C0_SCL_PIN, I2C_CLOCK_SPEED) == ESP_OK) {
+        ESP_LOGI("MAIN", "I2C0 (display) inicializado");
+        i2c0_bus.start_async_worker(I2C_WORKER_PRIORITY, I2C_WORKER_STACK_SIZE);
+        i2c0_topology.discover(I2C0_EXPECTED_DEVICES.addresses, I2C0_EXPECTED_DEVICES.count);
+        boot_timings.i2c0_topology_us = esp_timer_get_time() - phase_start;
+
+        // Inicializar display; a tela de boas-vindas fica até a primeira leitura
+        phase_start = esp_timer_get_time();
+        if (status_display.initialize_display() == ESP_OK) {
+            // Daqui em diante quem desenha só entrega o quadro; o I2C fica com a task
+            status_display.start_flush_task(DISPLAY_TASK_PRIORITY, DISPLAY_TASK_STACK_SIZE);
+            status_display.display_welcome_screen();
+        }
+        boot_timings.display_init_us = esp_timer_get_time() - phase_start;
+
+        initialize_multi_tire();
+    }
+
+    xEventGroupSetBits(boot_events, BOOT_DISPLAY_READY_BIT);
+    vTaskDelete(nullptr);
 }
 
 extern "C" void app_main(void) {
     // Inicializar NVS
+    int64_t phase_start = esp_timer_get_time();
     esp_err_t ret = nvs_flash_init();
     if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
         ESP_ERROR_CHECK(nvs_flash_erase());
         ret = nvs_flash_init();
     }
     ESP_ERROR_CHECK(ret);
+    boot_timings.nvs_init_us = esp_timer_get_time() - phase_start;
 
     ESP_LOGI("MAIN", "=== SISTEMA DE MEDIÇÃO DE PRESSÃO DE PNEUS ===");
 
-    // Inicializar I2C0 (Display)
-    if (i2c0_bus.initialize(I2C0_SDA_PIN, I2C0_SCL_PIN) == ESP_OK) {
-        ESP_LOGI("MAIN", "I2C0 (display) inicializado");
-        scan_i2c_bus(i2c0_bus, "I2C0");
-
-        // Inicializar display
-        if (status_display.initialize_display() == ESP_OK) {
-            status_display.display_welcome_screen();
-            vTaskDelay(pdMS_TO_TICKS(2000));
+    // Inicializar I2C0 (Display) em paralelo
+    boot_events = xEventGroupCreate();
+    if (boot_events == nullptr ||
+        xTaskCreate(display_init_task, "display_init", DISPLAY_INIT_TASK_STACK_SIZE, nullptr,
+                    DISPLAY_INIT_TASK_PRIORITY, nullptr) != pdPASS) {
+        ESP_LOGE("MAIN", "Falha ao criar task de inicialização do display");
+        if (boot_events != nullptr) {
+            xEventGroupSetBits(boot_events, BOOT_DISPLAY_READY_BIT);
         }
     }
 
     // Inicializar I2C1 (Sensores)
-    if (i2c1_bus.initialize(I2C1_SDA_PIN, I2C1_SCL_PIN) == ESP_OK) {
+    phase_start = esp_timer_get_time();
+    if (i2c1_bus.initialize(I2C1_SDA_PIN, I2C1_SCL_PIN, I2C_CLOCK_SPEED) == ESP_OK) {
         ESP_LOGI("MAIN", "I2C1 (sensores) inicializado");
-        scan_i2c_bus(i2c1_bus, "I2C1");
+        i2c1_bus.start_async_worker(I2C_WORKER_PRIORITY, I2C_WORKER_STACK_SIZE);
+        i2c1_topology.discover(I2C1_EXPECTED_DEVICES, sizeof(I2C1_EXPECTED_DEVICES));
+        boot_timings.i2c1_topology_us = esp_timer_get_time() - phase_start;
 
         // Inicializar sensores
+        phase_start = esp_timer_get_time();
         environmental_sensor.initialize_sensor();
+        boot_timings.bmp280_init_us = esp_timer_get_time() - phase_start;
+
+        phase_start = esp_timer_get_time();
         tire_pressure_sensor.initialize_sensor();
+        boot_timings.smp3011_init_us = esp_timer_get_time() - phase_start;
         
         // Inicializar botões
         button_control.initialize();
-        
-        // Inicializar system controller
+
+        // O controlador desenha no display: aguardar a task do I2C0
+        phase_start = esp_timer_get_time();
+        if (boot_events != nullptr) {
+            xEventGroupWaitBits(boot_events, BOOT_DISPLAY_READY_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+        }
+        boot_timings.display_wait_us = esp_timer_get_time() - phase_start;
+
+        // Inicializar system controller (faz a primeira leitura)
+        phase_start = esp_timer_get_time();
         system_controller.initialize();
+        boot_timings.controller_init_us = esp_timer_get_time() - phase_start;
+        boot_timings.first_reading_us = esp_timer_get_time();
+
+        // Captura contínua da pressão do pneu; o controlador consome o ring
+        if (tire_pressure_sensor.is_sensor_initialized()) {
+            tire_pressure_sensor.start_continuous_capture(TIRE_CAPTURE_RATE_HZ, SENSOR_TASK_PRIORITY,
+                                                          SENSOR_TASK_STACK_SIZE);
+        }
+
+        // Taxa adaptativa: começa em repouso e sobe enquanto a pressão varia
+        AdaptiveRateController::Config rate_config = AdaptiveRateController::DEFAULT_CONFIG;
+        rate_config.idle_rate_hz = TIRE_IDLE_RATE_HZ;
+        rate_config.max_rate_hz = TIRE_CAPTURE_RATE_HZ;
+        system_controller.configure_sample_rate(rate_config);
 
         ESP_LOGI("MAIN", "Sistema totalmente inicializado - Entrando no loop principal");
+        log_boot_timings();
+
+        if (RUN_FILTER_BENCHMARK) {
+            // Patamar e ruído na ordem das contagens do SMP3011, degrau de ~10 kPa
+            FilterBenchmark filter_benchmark(167772, 200, 5000);
+            filter_benchmark.run_standard_suite();
+        }
+        if (RUN_COMPENSATION_BENCHMARK && environmental_sensor.is_sensor_initialized()) {
+            BMP280CompensationBenchmark compensation_benchmark(environmental_sensor.get_calibration());
+            compensation_benchmark.run_all();
+        }
+        if (RUN_TEXT_BENCHMARK && status_display.is_display_initialized()) {
+            TextRenderBenchmark text_benchmark(&status_display);
+            text_benchmark.run_standard_suite();
+        }
+
+        I2CManager::TransferCounters i2c1_counters = i2c1_bus.get_transfer_counters();
+        ESP_LOGI("MAIN", "I2C1: %lu transações, %lu alocações de heap",
+                 (unsigned long)i2c1_counters.transactions, (unsigned long)i2c1_counters.heap_allocations);
 
         // Loop principal
+        TickType_t last_stats_log = xTaskGetTickCount();
+        TickType_t last_tire_scan = xTaskGetTickCount();
         while (true) {
             system_controller.process_events();
+            service_multi_tire(&last_tire_scan);
+
+            if (xTaskGetTickCount() - last_stats_log >= pdMS_TO_TICKS(I2C_STATS_LOG_INTERVAL_MS)) {
+                i2c0_bus.log_device_stats();
+                i2c1_bus.log_device_stats();
+
+                AdaptiveRateController::Stats rate_stats = system_controller.get_sample_rate_stats();
+                ESP_LOGI("MAIN", "Pneu: %.1f Hz, %lu amostras, %lu economizadas, %lu ativações",
+                         rate_stats.current_rate_hz, (unsigned long)rate_stats.samples_taken,
+                         (unsigned long)rate_stats.samples_saved, (unsigned long)rate_stats.activations);
+
+                SnapshotEngine::Stats snapshot_stats = system_controller.get_snapshot_stats();
+                ESP_LOGI("MAIN", "Snapshots: %lu (%lu parciais), defasagem média %lld us, máx %lld us "
+                         "(limite %lld us), aquisição máx %lu us",
+                         (unsigned long)snapshot_stats.snapshots, (unsigned long)snapshot_stats.partial_snapshots,
+                         snapshot_stats.mean_skew_us, snapshot_stats.max_skew_us, snapshot_stats.max_skew_bound_us,
+                         (unsigned long)snapshot_stats.max_acquisition_us);
+
+                if (tire_scheduler.get_sensor_count() > 0) {
+                    MultiTireScheduler::Stats tire_stats = tire_scheduler.get_stats();
+                    ESP_LOGI("MAIN", "Pneus: %lu ciclos, último %lu us, máx %lu us, %lu erros",
+                             (unsigned long)tire_stats.cycles, (unsigned long)tire_stats.last_cycle_us,
+                             (unsigned long)tire_stats.max_cycle_us, (unsigned long)tire_stats.errors);
+                }
+                last_stats_log = xTaskGetTickCount();
+            }
+
             vTaskDelay(pdMS_TO_TICKS(50)); // 20Hz
         }
     } else {
         ESP_LOGE("MAIN", "Falha crítica na inicialização do I2C1");
     }
-}
\ No newline at end of file
+}